@@ -1,22 +1,52 @@
-QT       += core gui
+QT       += core gui network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+# Build d'endurance (qmake CONFIG+=soak) : remplace new/delete globaux pour compter les allocations.
+# Désactivé par défaut pour ne pas ajouter d'instrumentation au jeu normal.
+soak: DEFINES += JRGAME_COUNT_ALLOCATIONS
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    assetcache.cpp \
+    enemy.cpp \
+    framecapture.cpp \
+    glyphatlas.cpp \
+    hud.cpp \
+    inputbuffer.cpp \
+    latencystats.cpp \
+    levelgenerator.cpp \
     main.cpp \
     mainwindow.cpp \
-    player.cpp
+    metrics.cpp \
+    metricsexporter.cpp \
+    occupancygrid.cpp \
+    player.cpp \
+    processstats.cpp \
+    soaktest.cpp
 
 HEADERS += \
+    assetcache.h \
     constants.h \
+    enemy.h \
+    framecapture.h \
+    glyphatlas.h \
+    hud.h \
+    inputbuffer.h \
+    latencystats.h \
+    levelgenerator.h \
     mainwindow.h \
-    player.h
+    metrics.h \
+    metricsexporter.h \
+    occupancygrid.h \
+    player.h \
+    processstats.h \
+    soaktest.h
 
 FORMS += \
     mainwindow.ui
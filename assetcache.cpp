@@ -0,0 +1,172 @@
+#include "assetcache.h"
+#include "constants.h"
+#include "metrics.h"
+#include <QFile>
+
+namespace {
+
+// Miroir des statistiques du cache dans le registre de métriques
+struct CacheMetrics {
+    MetricCounter* hits;
+    MetricCounter* misses;
+    MetricCounter* evictions;
+    MetricGauge* bytesUsed;
+    MetricGauge* entries;
+};
+
+const CacheMetrics& metrics() {
+    static const CacheMetrics cacheMetrics = [] {
+        MetricsRegistry& registry = MetricsRegistry::instance();
+        return CacheMetrics{
+            registry.counter(QStringLiteral("jrgame_asset_cache_hits_total"), QStringLiteral("Ressources servies par le cache")),
+            registry.counter(QStringLiteral("jrgame_asset_cache_misses_total"), QStringLiteral("Ressources décodées (absentes du cache)")),
+            registry.counter(QStringLiteral("jrgame_asset_cache_evictions_total"), QStringLiteral("Ressources évincées du cache")),
+            registry.gauge(QStringLiteral("jrgame_asset_cache_bytes"), QStringLiteral("Mémoire occupée par le cache de ressources")),
+            registry.gauge(QStringLiteral("jrgame_asset_cache_entries"), QStringLiteral("Ressources présentes dans le cache")),
+        };
+    }();
+    return cacheMetrics;
+}
+
+} // namespace
+
+AssetCache& AssetCache::instance() {
+    static AssetCache cache;
+    return cache;
+}
+
+AssetCache::AssetCache()
+    : m_budgetBytes(ASSET_CACHE_BUDGET_BYTES),
+    m_bytesUsed(0),
+    m_useCounter(0),
+    m_hits(0),
+    m_misses(0),
+    m_evictions(0)
+{
+}
+
+// --- Accès aux ressources ---
+
+AssetCache::PixmapHandle AssetCache::pixmap(const QString& path) {
+    const QString key = entryKey(Kind::Pixmap, path);
+    if (Entry* entry = lookup(key)) {
+        return entry->pixmap;
+    }
+
+    // Absent du cache : décodage unique
+    ++m_misses;
+    metrics().misses->inc();
+    QPixmap decoded;
+    if (!decoded.load(path)) {
+        insert(key, Entry()); // Entrée négative : le chemin ne sera pas redécodé
+        return nullptr; // L'appelant signale l'erreur avec son propre contexte
+    }
+
+    Entry entry;
+    entry.bytes = qint64(decoded.width()) * decoded.height() * decoded.depth() / 8;
+    entry.pixmap = std::make_shared<const QPixmap>(decoded);
+    PixmapHandle handle = entry.pixmap;
+    insert(key, std::move(entry));
+    return handle;
+}
+
+AssetCache::AudioHandle AssetCache::audio(const QString& path) {
+    const QString key = entryKey(Kind::Audio, path);
+    if (Entry* entry = lookup(key)) {
+        return entry->audio;
+    }
+
+    ++m_misses;
+    metrics().misses->inc();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        insert(key, Entry());
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.audio = std::make_shared<const QByteArray>(file.readAll());
+    entry.bytes = entry.audio->size();
+    AudioHandle handle = entry.audio;
+    insert(key, std::move(entry));
+    return handle;
+}
+
+// --- Budget et statistiques ---
+
+void AssetCache::setBudget(qint64 bytes) {
+    m_budgetBytes = bytes;
+    trim();
+}
+
+qint64 AssetCache::budget() const {
+    return m_budgetBytes;
+}
+
+AssetCache::Stats AssetCache::stats() const {
+    Stats s;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    s.evictions = m_evictions;
+    s.bytesUsed = m_bytesUsed;
+    s.budgetBytes = m_budgetBytes;
+    s.entries = m_entries.size();
+    return s;
+}
+
+void AssetCache::trim() {
+    evictUnused(m_budgetBytes);
+}
+
+void AssetCache::clearUnused() {
+    evictUnused(0);
+}
+
+// --- Fonctions Helper ---
+
+QString AssetCache::entryKey(Kind kind, const QString& path) {
+    return (kind == Kind::Pixmap ? QStringLiteral("pixmap:") : QStringLiteral("audio:")) + path;
+}
+
+// Retourne l'entrée (et la marque comme récemment utilisée) ou nullptr
+AssetCache::Entry* AssetCache::lookup(const QString& key) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return nullptr;
+    ++m_hits;
+    metrics().hits->inc();
+    it->lastUse = ++m_useCounter;
+    return &it.value();
+}
+
+void AssetCache::insert(const QString& key, Entry entry) {
+    entry.lastUse = ++m_useCounter;
+    m_bytesUsed += entry.bytes;
+    m_entries.insert(key, std::move(entry));
+    // La nouvelle entrée est référencée par l'appelant, elle ne peut pas être évincée ici
+    evictUnused(m_budgetBytes); // Publie aussi les métriques
+}
+
+void AssetCache::publishMetrics() const {
+    metrics().bytesUsed->set(m_bytesUsed);
+    metrics().entries->set(m_entries.size());
+}
+
+// Évince les entrées inutilisées, la moins récemment utilisée d'abord, jusqu'à atteindre targetBytes.
+// Les entrées encore référencées sont conservées même si le budget est dépassé.
+void AssetCache::evictUnused(qint64 targetBytes) {
+    while (m_bytesUsed > targetBytes) {
+        auto victim = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->isUnused() && (victim == m_entries.end() || it->lastUse < victim->lastUse)) {
+                victim = it;
+            }
+        }
+        if (victim == m_entries.end()) break; // Tout est encore utilisé
+
+        m_bytesUsed -= victim->bytes;
+        m_entries.erase(victim);
+        ++m_evictions;
+        metrics().evictions->inc();
+    }
+    publishMetrics();
+}
@@ -0,0 +1,80 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QPixmap>
+#include <QString>
+#include <memory>
+
+// Cache central des ressources (pixmaps et sons), indexé par chemin de ressource (":/images/...").
+// Chaque ressource n'est décodée qu'une seule fois ; toutes les entités partagent le même handle,
+// donc la mémoire reste stable qu'il y ait 1 ou 10 000 goombas.
+// Les ressources qui ne sont plus référencées que par le cache sont évincées (LRU) quand le budget est dépassé.
+// À utiliser uniquement depuis le thread GUI (QPixmap n'est pas thread-safe).
+class AssetCache
+{
+public:
+    using PixmapHandle = std::shared_ptr<const QPixmap>;
+    using AudioHandle = std::shared_ptr<const QByteArray>;
+
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+        qint64 bytesUsed = 0;
+        qint64 budgetBytes = 0;
+        int entries = 0;
+    };
+
+    static AssetCache& instance();
+
+    // --- Accès aux ressources (nullptr si le chargement échoue, échec mémorisé) ---
+    PixmapHandle pixmap(const QString& path);
+    AudioHandle audio(const QString& path);
+
+    // --- Budget et statistiques ---
+    void setBudget(qint64 bytes);
+    qint64 budget() const;
+    Stats stats() const;
+    void trim(); // Évince les ressources inutilisées jusqu'à repasser sous le budget
+    void clearUnused(); // Évince toutes les ressources inutilisées
+
+private:
+    AssetCache();
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    enum class Kind { Pixmap, Audio };
+
+    // Une entrée sans handle (0 octet) mémorise un échec de chargement : chaque chemin n'est essayé qu'une fois
+    struct Entry {
+        PixmapHandle pixmap;
+        AudioHandle audio;
+        qint64 bytes = 0;
+        quint64 lastUse = 0;
+
+        bool isNegative() const { return !pixmap && !audio; }
+        // Inutilisée = seul le cache détient encore le handle ; les entrées négatives ne libèrent rien, elles restent
+        bool isUnused() const {
+            if (isNegative()) return false;
+            return pixmap ? pixmap.use_count() == 1 : audio.use_count() == 1;
+        }
+    };
+
+    static QString entryKey(Kind kind, const QString& path); // Un même chemin peut exister sous les deux types
+    Entry* lookup(const QString& key);
+    void insert(const QString& key, Entry entry);
+    void evictUnused(qint64 targetBytes);
+    void publishMetrics() const;
+
+    QHash<QString, Entry> m_entries;
+    qint64 m_budgetBytes;
+    qint64 m_bytesUsed;
+    quint64 m_useCounter; // Horloge logique pour l'ordre LRU
+    quint64 m_hits;
+    quint64 m_misses;
+    quint64 m_evictions;
+};
+
+#endif // ASSETCACHE_H
@@ -12,8 +12,75 @@ constexpr int COLLISION_MARGIN_RIGHT = 10;
 constexpr int COLLISION_MARGIN_TOP = 10;
 constexpr int COLLISION_MARGIN_BOTTOM = 10;
 
+constexpr int TICK_INTERVAL_MS = 16; // Pas de simulation (~60 Hz)
+
+// Tolérances de saut : appui mémorisé avant l'atterrissage, et délai de grâce après avoir quitté le sol
+constexpr int JUMP_BUFFER_MS = 100;
+constexpr int COYOTE_TIME_MS = 80;
+constexpr int LATENCY_SAMPLE_CAPACITY = 4096; // Échantillons gardés pour les percentiles de latence
+
 constexpr double GRAVITY = 0.8;
 constexpr double JUMP_STRENGTH = -15.0;
 constexpr double MAX_FALL_SPEED = 15.0;
 
+// HUD : atlas de glyphes et disposition des compteurs
+constexpr int HUD_FONT_PIXEL_SIZE = 24;
+constexpr int HUD_GLYPH_PADDING = 3; // Marge autour de chaque glyphe de l'atlas (débordements, ombre)
+constexpr int HUD_SHADOW_OFFSET = 2;
+constexpr int HUD_SCORE_DIGITS = 6;
+constexpr int HUD_COIN_DIGITS = 2;
+constexpr int HUD_TIME_DIGITS = 3;
+constexpr int HUD_MARGIN = 10;
+constexpr int HUD_ITEM_SPACING = 6;
+constexpr int HUD_GROUP_SPACING = 40;
+constexpr int LEVEL_TIME_SECONDS = 400;
+
+// Capture hors écran
+constexpr int CAPTURE_DEFAULT_FRAMES = 600; // 10 s de jeu à ~60 Hz
+constexpr int CAPTURE_BUFFERS_PER_ENCODER = 2; // Un tampon en encodage, un prêt à être rempli
+constexpr int CAPTURE_PNG_QUALITY = 80; // Compression PNG plus légère : l'encodage reste plus rapide que le rendu
+
+// Ennemis (goomba : images de 122x97 dans goomba.png, affichées réduites)
+constexpr int GOOMBA_FRAME_WIDTH = 122;
+constexpr int GOOMBA_FRAME_HEIGHT = 97;
+constexpr int ENEMY_WIDTH = 50;
+constexpr int ENEMY_HEIGHT = 40;
+
+// Génération procédurale de niveaux (tests de charge)
+constexpr int LEVEL_DEFAULT_WIDTH = 200000;
+constexpr int LEVEL_GROUND_HEIGHT = 40;
+constexpr int LEVEL_SEGMENT_MIN_LENGTH = 200;
+constexpr int LEVEL_SEGMENT_MAX_LENGTH = 800;
+constexpr int LEVEL_GAP_MIN = 60;
+constexpr int LEVEL_GAP_MAX = 150; // Reste franchissable : ~185 px parcourus pendant un saut
+constexpr int LEVEL_PLATFORM_MIN_WIDTH = 80;
+constexpr int LEVEL_PLATFORM_MAX_WIDTH = 200;
+constexpr int LEVEL_PLATFORM_HEIGHT = 20;
+constexpr int LEVEL_PLATFORM_MIN_LIFT = 100; // Le joueur passe dessous sans se cogner
+constexpr int LEVEL_PLATFORM_MAX_LIFT = 130; // Hauteur de saut max ~140 px
+constexpr int LEVEL_PLATFORM_MIN_SPACING = 60;
+constexpr int LEVEL_PLATFORM_MAX_SPACING = 220;
+constexpr int LEVEL_UPPER_PLATFORM_PERCENT = 30;
+constexpr int LEVEL_ENEMY_MIN_SPACING = 250;
+constexpr int LEVEL_ENEMY_MAX_SPACING = 600;
+constexpr int LEVEL_SPAWN_CLEARANCE = 300; // Zone de départ sans plateforme ni ennemi
+constexpr int LEVEL_SPAWN_X = 50;
+constexpr int LEVEL_SPAWN_DROP = 100;
+
+// Test d'endurance (soak)
+constexpr int SOAK_DEFAULT_SECONDS = 120;
+constexpr int SOAK_WINDOW_TICKS = 600; // ~10 s simulées par fenêtre de mesure
+constexpr int SOAK_WARMUP_WINDOWS = 1; // Fenêtres ignorées (caches, polices, premières allocations)
+constexpr int SOAK_TREND_WINDOWS = 3; // Fenêtres moyennées en début et en fin de test pour comparer
+constexpr double SOAK_MAX_MEMORY_GROWTH = 0.10; // +10 % de tas/RSS entre début et fin = fuite
+constexpr double SOAK_MAX_LATENCY_DRIFT = 0.50; // +50 % sur le p95 du temps de frame = dérive
+constexpr double SOAK_MIN_LATENCY_DRIFT_MS = 1.0; // En dessous, la dérive est considérée comme du bruit
+
+// Export des métriques : socket locale (remplaçable par la variable d'environnement JR_GAME_METRICS_SOCKET)
+constexpr const char* METRICS_SOCKET_NAME = "jr-game-metrics";
+constexpr int METRICS_PLAIN_REPLY_DELAY_MS = 100; // Attente d'une requête HTTP avant de répondre en texte brut
+constexpr int METRICS_PROBE_TIMEOUT_MS = 200; // Délai pour vérifier si une autre instance occupe déjà la socket
+
+constexpr long long ASSET_CACHE_BUDGET_BYTES = 64LL * 1024 * 1024; // Budget mémoire du cache de ressources
+
 #endif // CONSTANTS_H
@@ -0,0 +1,29 @@
+#include "enemy.h"
+#include "constants.h"
+#include <QDebug>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QSet>
+
+Enemy::Enemy(const QString& spritePath, const QSize& frameSize, QWidget* parent)
+    : QWidget(parent),
+    m_spritesheet(AssetCache::instance().pixmap(spritePath)),
+    m_frameSize(frameSize)
+{
+    // Un seul avertissement par chemin, même avec des milliers d'ennemis
+    static QSet<QString> reportedPaths;
+    if (!m_spritesheet && !reportedPaths.contains(spritePath)) {
+        reportedPaths.insert(spritePath);
+        qWarning() << "ERREUR: Impossible de charger le spritesheet" << spritePath << ". Vérifiez le fichier de ressources (qrc).";
+    }
+    setFixedSize(ENEMY_WIDTH, ENEMY_HEIGHT);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+}
+
+void Enemy::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    if (!m_spritesheet) return;
+
+    QPainter painter(this);
+    painter.drawPixmap(rect(), *m_spritesheet, QRect(QPoint(0, 0), m_frameSize));
+}
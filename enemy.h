@@ -0,0 +1,26 @@
+#ifndef ENEMY_H
+#define ENEMY_H
+
+#include <QWidget>
+#include "assetcache.h"
+
+class QPaintEvent;
+
+// Ennemi statique (pour l'instant sans comportement) : affiche la première image de son spritesheet.
+// Le spritesheet vient d'AssetCache, donc toutes les instances partagent le même pixmap.
+class Enemy : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Enemy(const QString& spritePath, const QSize& frameSize, QWidget* parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    AssetCache::PixmapHandle m_spritesheet;
+    QSize m_frameSize; // Taille d'une image dans le spritesheet
+};
+
+#endif // ENEMY_H
@@ -0,0 +1,134 @@
+#include "framecapture.h"
+#include "constants.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+
+FrameCapture::FrameCapture(const Options& options)
+    : m_options(options),
+    m_stopping(false),
+    m_framesWritten(0),
+    m_failures(0)
+{
+    m_options.encoderThreads = std::max(1, m_options.encoderThreads);
+    m_options.bufferCount = std::max(1, m_options.bufferCount);
+    QDir().mkpath(m_options.outputDir);
+
+    // Tampons alloués une fois pour toute la capture, puis recyclés
+    for (int i = 0; i < m_options.bufferCount; ++i) {
+        m_buffers.emplace_back(new QImage(m_options.frameSize, QImage::Format_ARGB32_Premultiplied));
+        m_freeBuffers.enqueue(m_buffers.back().get());
+    }
+
+    if (m_options.format == Format::Raw) {
+        writeRawDescription();
+    }
+
+    for (int i = 0; i < m_options.encoderThreads; ++i) {
+        QThread* encoder = QThread::create([this]() { encoderLoop(); });
+        encoder->setObjectName(QStringLiteral("frame-encoder-%1").arg(i));
+        encoder->start();
+        m_encoders.append(encoder);
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    finish();
+}
+
+QImage* FrameCapture::acquireBuffer() {
+    QMutexLocker locker(&m_mutex);
+    while (m_freeBuffers.isEmpty()) {
+        m_bufferFreed.wait(&m_mutex);
+    }
+    return m_freeBuffers.dequeue();
+}
+
+void FrameCapture::submit(QImage* buffer, int frameIndex) {
+    QMutexLocker locker(&m_mutex);
+    m_jobs.enqueue(Job{buffer, frameIndex});
+    m_jobQueued.wakeOne();
+}
+
+void FrameCapture::finish() {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_stopping) return;
+        m_stopping = true; // Les encodeurs vident la file avant de s'arrêter
+        m_jobQueued.wakeAll();
+    }
+    for (QThread* encoder : m_encoders) {
+        encoder->wait();
+        delete encoder;
+    }
+    m_encoders.clear();
+}
+
+bool FrameCapture::parseFormat(const QString& name, Format& format) {
+    if (name.compare(QLatin1String("png"), Qt::CaseInsensitive) == 0) {
+        format = Format::Png;
+        return true;
+    }
+    if (name.compare(QLatin1String("raw"), Qt::CaseInsensitive) == 0) {
+        format = Format::Raw;
+        return true;
+    }
+    return false;
+}
+
+// --- Fonctions Helper ---
+
+void FrameCapture::encoderLoop() {
+    forever {
+        Job job;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_jobs.isEmpty() && !m_stopping) {
+                m_jobQueued.wait(&m_mutex);
+            }
+            if (m_jobs.isEmpty()) return; // Arrêt demandé et file vide
+            job = m_jobs.dequeue();
+        }
+
+        // Le tampon n'est touché par personne d'autre pendant l'encodage : lecture seule, hors verrou
+        if (encode(*job.buffer, job.frameIndex)) {
+            m_framesWritten.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_failures.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        QMutexLocker locker(&m_mutex);
+        m_freeBuffers.enqueue(job.buffer);
+        m_bufferFreed.wakeOne();
+    }
+}
+
+bool FrameCapture::encode(const QImage& image, int frameIndex) const {
+    const QString baseName = QStringLiteral("frame_%1").arg(frameIndex, 6, 10, QLatin1Char('0'));
+    const QDir dir(m_options.outputDir);
+
+    if (m_options.format == Format::Png) {
+        return image.save(dir.filePath(baseName + QStringLiteral(".png")), "PNG", CAPTURE_PNG_QUALITY);
+    }
+
+    // Brut : les lignes telles qu'en mémoire (ARGB32 prémultiplié, voir capture.txt)
+    QFile file(dir.filePath(baseName + QStringLiteral(".raw")));
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    const qint64 bytes = qint64(image.bytesPerLine()) * image.height();
+    return file.write(reinterpret_cast<const char*>(image.constBits()), bytes) == bytes;
+}
+
+void FrameCapture::writeRawDescription() const {
+    QFile file(QDir(m_options.outputDir).filePath(QStringLiteral("capture.txt")));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "ERREUR: Impossible d'écrire la description de capture dans" << m_options.outputDir;
+        return;
+    }
+    const QImage& sample = *m_buffers.front();
+    file.write(QStringLiteral("width=%1\nheight=%2\nbytesPerLine=%3\nformat=ARGB32_Premultiplied\n")
+                   .arg(sample.width()).arg(sample.height()).arg(sample.bytesPerLine())
+                   .toUtf8());
+}
@@ -0,0 +1,71 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+// Capture d'images vers des fichiers, encodées par un pool de threads.
+// Un nombre fixe de QImage est alloué une seule fois : le rendu remplit un tampon libre, le confie
+// (par pointeur, sans copie) à un encodeur, qui le rend au pool une fois le fichier écrit.
+// Si tous les tampons sont en cours d'encodage, acquireBuffer() bloque : la mémoire reste bornée.
+class FrameCapture
+{
+public:
+    enum class Format { Png, Raw };
+
+    struct Options {
+        QString outputDir;
+        Format format = Format::Png;
+        int encoderThreads = 1;
+        int bufferCount = 2;
+        QSize frameSize;
+    };
+
+    explicit FrameCapture(const Options& options);
+    ~FrameCapture();
+
+    QImage* acquireBuffer(); // Thread de rendu uniquement
+    void submit(QImage* buffer, int frameIndex); // Le tampon appartient à l'encodeur jusqu'à son retour au pool
+    void finish(); // Attend l'écriture de toutes les images soumises et arrête les encodeurs
+
+    int framesWritten() const { return m_framesWritten.load(std::memory_order_relaxed); }
+    int failures() const { return m_failures.load(std::memory_order_relaxed); }
+
+    static bool parseFormat(const QString& name, Format& format);
+
+private:
+    struct Job {
+        QImage* buffer;
+        int frameIndex;
+    };
+
+    void encoderLoop();
+    bool encode(const QImage& image, int frameIndex) const;
+    void writeRawDescription() const;
+
+    Options m_options;
+    std::vector<std::unique_ptr<QImage>> m_buffers;
+    QVector<QThread*> m_encoders;
+
+    QMutex m_mutex;
+    QWaitCondition m_bufferFreed;
+    QWaitCondition m_jobQueued;
+    QQueue<QImage*> m_freeBuffers;
+    QQueue<Job> m_jobs;
+    bool m_stopping;
+
+    std::atomic<int> m_framesWritten;
+    std::atomic<int> m_failures;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,114 @@
+#include "glyphatlas.h"
+#include "constants.h"
+#include <QDebug>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QImage>
+#include <QPainter>
+#include <QStringList>
+
+// --- GlyphAtlas ---
+
+GlyphAtlas::GlyphAtlas(const QFont& font, const QString& glyphs, const QColor& color)
+    : m_padding(HUD_GLYPH_PADDING)
+{
+    QFontMetrics metrics(font);
+    int cellHeight = metrics.height() + 2 * m_padding;
+
+    // Cellules alignées horizontalement ; la marge absorbe les débordements et l'ombre portée
+    int atlasWidth = 0;
+    for (QChar glyph : glyphs) {
+        if (m_glyphs.contains(glyph)) continue;
+        int advance = metrics.horizontalAdvance(glyph);
+        int cellWidth = advance + 2 * m_padding;
+        m_glyphs.insert(glyph, Glyph{QRect(atlasWidth, 0, cellWidth, cellHeight), advance});
+        atlasWidth += cellWidth;
+    }
+
+    QImage image(qMax(1, atlasWidth), cellHeight, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setFont(font);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    for (auto it = m_glyphs.cbegin(); it != m_glyphs.cend(); ++it) {
+        QPoint baseline(it->source.x() + m_padding, m_padding + metrics.ascent());
+        painter.setPen(Qt::black); // Ombre portée pour rester lisible sur tous les fonds
+        painter.drawText(baseline + QPoint(HUD_SHADOW_OFFSET, HUD_SHADOW_OFFSET), QString(it.key()));
+        painter.setPen(color);
+        painter.drawText(baseline, QString(it.key()));
+    }
+    painter.end();
+
+    m_pixmap = QPixmap::fromImage(image);
+}
+
+QRect GlyphAtlas::sourceRect(QChar glyph) const {
+    return m_glyphs.value(glyph).source;
+}
+
+int GlyphAtlas::advance(QChar glyph) const {
+    return m_glyphs.value(glyph).advance;
+}
+
+QFont GlyphAtlas::loadFont(const QString& resourcePath, int pixelSize) {
+    QFont font;
+    int id = QFontDatabase::addApplicationFont(resourcePath);
+    const QStringList families = QFontDatabase::applicationFontFamilies(id);
+    if (id < 0 || families.isEmpty()) {
+        qWarning() << "ERREUR: Impossible de charger la police" << resourcePath << ". Vérifiez le fichier de ressources (qrc).";
+    } else {
+        font.setFamily(families.first());
+    }
+    font.setPixelSize(pixelSize);
+    return font;
+}
+
+// --- HudCounter ---
+
+HudCounter::HudCounter(const GlyphAtlas* atlas, int minDigits, const QString& prefix)
+    : m_atlas(atlas),
+    m_minDigits(minDigits),
+    m_prefix(prefix),
+    m_value(0)
+{
+    relayout();
+}
+
+bool HudCounter::setValue(int value) {
+    if (value == m_value) return false;
+    m_value = value;
+    relayout();
+    return true;
+}
+
+void HudCounter::setPosition(const QPoint& topLeft) {
+    if (topLeft == m_position) return;
+    m_position = topLeft;
+    relayout();
+}
+
+// Calcule une fois la liste des copies atlas -> écran pour la valeur courante
+void HudCounter::relayout() {
+    const QString text = m_prefix + QString::number(m_value).rightJustified(m_minDigits, QLatin1Char('0'));
+
+    m_blits.clear();
+    m_blits.reserve(text.size());
+    int penX = m_position.x();
+    for (QChar glyph : text) {
+        if (!m_atlas->contains(glyph)) continue;
+        m_blits.append(Blit{QPoint(penX - m_atlas->padding(), m_position.y() - m_atlas->padding()), m_atlas->sourceRect(glyph)});
+        penX += m_atlas->advance(glyph);
+    }
+
+    QRect bounds;
+    for (const Blit& blit : m_blits) {
+        bounds |= QRect(blit.target, blit.source.size());
+    }
+    m_bounds = bounds;
+}
+
+void HudCounter::draw(QPainter& painter) const {
+    for (const Blit& blit : m_blits) {
+        painter.drawPixmap(blit.target, m_atlas->pixmap(), blit.source);
+    }
+}
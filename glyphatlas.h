@@ -0,0 +1,73 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QPixmap>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+class QPainter;
+
+// Atlas de glyphes pré-rastérisés : chaque caractère est dessiné une seule fois dans un pixmap,
+// puis le texte est affiché par simples copies de rectangles (pas de mise en forme à chaque image).
+class GlyphAtlas
+{
+public:
+    GlyphAtlas(const QFont& font, const QString& glyphs, const QColor& color);
+
+    bool contains(QChar glyph) const { return m_glyphs.contains(glyph); }
+    QRect sourceRect(QChar glyph) const; // Cellule du glyphe dans l'atlas (marges comprises)
+    int advance(QChar glyph) const;
+    int padding() const { return m_padding; }
+    int height() const { return m_pixmap.height(); }
+    const QPixmap& pixmap() const { return m_pixmap; }
+
+    // Charge une police des ressources (":/font/...") ; retourne la police par défaut en cas d'échec
+    static QFont loadFont(const QString& resourcePath, int pixelSize);
+
+private:
+    struct Glyph {
+        QRect source;
+        int advance;
+    };
+
+    QHash<QChar, Glyph> m_glyphs;
+    QPixmap m_pixmap;
+    int m_padding;
+};
+
+// Compteur numérique affiché via un GlyphAtlas. La disposition (liste de copies) n'est recalculée
+// que lorsque la valeur change ; le dessin se limite ensuite à blitter les cellules mémorisées.
+class HudCounter
+{
+public:
+    HudCounter(const GlyphAtlas* atlas, int minDigits, const QString& prefix = QString());
+
+    bool setValue(int value); // Retourne vrai si la valeur (donc l'affichage) a changé
+    int value() const { return m_value; }
+    void setPosition(const QPoint& topLeft);
+    QRect bounds() const { return m_bounds; }
+    void draw(QPainter& painter) const;
+
+private:
+    void relayout();
+
+    struct Blit {
+        QPoint target;
+        QRect source;
+    };
+
+    const GlyphAtlas* m_atlas;
+    int m_minDigits;
+    QString m_prefix;
+    int m_value;
+    QPoint m_position;
+    QRect m_bounds;
+    QVector<Blit> m_blits;
+};
+
+#endif // GLYPHATLAS_H
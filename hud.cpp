@@ -0,0 +1,108 @@
+#include "hud.h"
+#include "constants.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <algorithm>
+
+namespace {
+
+const QString HUD_DIGITS = QStringLiteral("0123456789x");
+
+int iconHeight(const AssetCache::PixmapHandle& icon) {
+    return icon ? icon->height() : 0;
+}
+
+int iconWidth(const AssetCache::PixmapHandle& icon) {
+    return icon ? icon->width() : 0;
+}
+
+} // namespace
+
+Hud::Hud(QWidget* parent)
+    : QWidget(parent),
+    m_marioAtlas(GlyphAtlas::loadFont(":/font/SuperMario256.ttf", HUD_FONT_PIXEL_SIZE), HUD_DIGITS, Qt::white),
+    m_coinAtlas(GlyphAtlas::loadFont(":/font/CoinCount2.ttf", HUD_FONT_PIXEL_SIZE), HUD_DIGITS, Qt::white),
+    m_score(&m_marioAtlas, HUD_SCORE_DIGITS),
+    m_coins(&m_coinAtlas, HUD_COIN_DIGITS, QStringLiteral("x")),
+    m_time(&m_marioAtlas, HUD_TIME_DIGITS),
+    m_scoreIcon(AssetCache::instance().pixmap(":/images/scoretext.png")),
+    m_coinIcon(AssetCache::instance().pixmap(":/images/count.png")),
+    m_clockIcon(AssetCache::instance().pixmap(":/images/clock.png"))
+{
+    // Purement informatif : ne doit pas intercepter la souris ni le focus clavier
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+
+    layoutItems();
+    resize(sizeHint());
+}
+
+void Hud::setScore(int score) {
+    setCounterValue(m_score, score);
+}
+
+void Hud::setCoins(int coins) {
+    setCounterValue(m_coins, coins);
+}
+
+void Hud::setTimeRemaining(int seconds) {
+    setCounterValue(m_time, seconds);
+}
+
+QSize Hud::sizeHint() const {
+    return m_contentSize;
+}
+
+// Seule la zone du compteur modifié (ancienne et nouvelle étendue) est invalidée
+void Hud::setCounterValue(HudCounter& counter, int value) {
+    QRect previous = counter.bounds();
+    if (counter.setValue(value)) {
+        update(previous | counter.bounds());
+    }
+}
+
+// Place icônes et compteurs une seule fois, de gauche à droite, centrés verticalement
+void Hud::layoutItems() {
+    int rowHeight = std::max({iconHeight(m_scoreIcon), iconHeight(m_coinIcon), iconHeight(m_clockIcon),
+                              m_marioAtlas.height(), m_coinAtlas.height()});
+    int textY = (rowHeight - (m_marioAtlas.height() - 2 * m_marioAtlas.padding())) / 2;
+    int coinTextY = (rowHeight - (m_coinAtlas.height() - 2 * m_coinAtlas.padding())) / 2;
+
+    int x = HUD_MARGIN;
+    m_scoreIconPos = QPoint(x, (rowHeight - iconHeight(m_scoreIcon)) / 2);
+    x += iconWidth(m_scoreIcon) + HUD_ITEM_SPACING;
+    m_score.setPosition(QPoint(x, textY));
+    x = m_score.bounds().right() + HUD_GROUP_SPACING;
+
+    m_coinIconPos = QPoint(x, (rowHeight - iconHeight(m_coinIcon)) / 2);
+    x += iconWidth(m_coinIcon) + HUD_ITEM_SPACING;
+    m_coins.setPosition(QPoint(x, coinTextY));
+    x = m_coins.bounds().right() + HUD_GROUP_SPACING;
+
+    m_clockIconPos = QPoint(x, (rowHeight - iconHeight(m_clockIcon)) / 2);
+    x += iconWidth(m_clockIcon) + HUD_ITEM_SPACING;
+    m_time.setPosition(QPoint(x, textY));
+    x = m_time.bounds().right() + HUD_MARGIN;
+
+    m_contentSize = QSize(x, rowHeight);
+}
+
+void Hud::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    const QRect dirty = event->rect();
+
+    auto drawIcon = [&](const AssetCache::PixmapHandle& icon, const QPoint& pos) {
+        if (icon && dirty.intersects(QRect(pos, icon->size()))) {
+            painter.drawPixmap(pos, *icon);
+        }
+    };
+    drawIcon(m_scoreIcon, m_scoreIconPos);
+    drawIcon(m_coinIcon, m_coinIconPos);
+    drawIcon(m_clockIcon, m_clockIconPos);
+
+    for (const HudCounter* counter : {&m_score, &m_coins, &m_time}) {
+        if (dirty.intersects(counter->bounds())) {
+            counter->draw(painter);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <QWidget>
+#include "assetcache.h"
+#include "glyphatlas.h"
+
+class QPaintEvent;
+
+// Bandeau d'informations (score, pièces, temps) superposé à la scène.
+// Les chiffres sont blittés depuis des atlas de glyphes ; seule la zone d'un compteur modifié est redessinée.
+class Hud : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Hud(QWidget* parent = nullptr);
+
+    void setScore(int score);
+    void setCoins(int coins);
+    void setTimeRemaining(int seconds);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    void layoutItems();
+    void setCounterValue(HudCounter& counter, int value);
+
+    GlyphAtlas m_marioAtlas; // SuperMario256 : score et temps
+    GlyphAtlas m_coinAtlas;  // CoinCount2 : nombre de pièces
+    HudCounter m_score;
+    HudCounter m_coins;
+    HudCounter m_time;
+
+    AssetCache::PixmapHandle m_scoreIcon;
+    AssetCache::PixmapHandle m_coinIcon;
+    AssetCache::PixmapHandle m_clockIcon;
+    QPoint m_scoreIconPos;
+    QPoint m_coinIconPos;
+    QPoint m_clockIconPos;
+    QSize m_contentSize;
+};
+
+#endif // HUD_H
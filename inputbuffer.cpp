@@ -0,0 +1,21 @@
+#include "inputbuffer.h"
+#include <chrono>
+
+void InputBuffer::push(Action action, bool pressed) {
+    push(Event{action, pressed, nowNs()});
+}
+
+void InputBuffer::push(const Event& event) {
+    m_events.append(event);
+}
+
+QVector<InputBuffer::Event> InputBuffer::takeAll() {
+    QVector<Event> events;
+    events.swap(m_events);
+    return events;
+}
+
+qint64 InputBuffer::nowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
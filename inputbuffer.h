@@ -0,0 +1,32 @@
+#ifndef INPUTBUFFER_H
+#define INPUTBUFFER_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// File d'entrées horodatées, remplie par les événements clavier et vidée au début de chaque tick de simulation.
+// Les horodatages utilisent une horloge monotone (nowNs()) pour pouvoir mesurer la latence entrée -> dessin.
+// Producteur et consommateur tournent sur le thread GUI : pas de verrou.
+class InputBuffer
+{
+public:
+    enum class Action { MoveLeft, MoveRight, Jump };
+
+    struct Event {
+        Action action;
+        bool pressed;
+        qint64 timestampNs;
+    };
+
+    void push(Action action, bool pressed);
+    void push(const Event& event);
+    QVector<Event> takeAll(); // Vide la file et retourne les événements dans l'ordre d'arrivée
+    bool isEmpty() const { return m_events.isEmpty(); }
+
+    static qint64 nowNs(); // Horloge monotone partagée (nanosecondes)
+
+private:
+    QVector<Event> m_events;
+};
+
+#endif // INPUTBUFFER_H
@@ -0,0 +1,51 @@
+#include "latencystats.h"
+#include <algorithm>
+#include <cmath>
+
+LatencyStats::LatencyStats(int capacity)
+    : m_capacity(std::max(1, capacity)),
+    m_next(0),
+    m_totalSamples(0)
+{
+    m_samples.reserve(m_capacity);
+}
+
+void LatencyStats::addSample(qint64 ns) {
+    ++m_totalSamples;
+    if (m_samples.size() < m_capacity) {
+        m_samples.append(ns);
+        return;
+    }
+    m_samples[m_next] = ns;
+    m_next = (m_next + 1) % m_capacity;
+}
+
+void LatencyStats::reset() {
+    m_samples.clear();
+    m_next = 0;
+    m_totalSamples = 0;
+}
+
+qint64 LatencyStats::percentileNs(double percentile) const {
+    if (m_samples.isEmpty()) return 0;
+
+    // Copie locale : nth_element réordonne les données
+    QVector<qint64> sorted = m_samples;
+    double clamped = std::min(100.0, std::max(0.0, percentile));
+    int index = static_cast<int>(std::ceil(clamped / 100.0 * sorted.size())) - 1;
+    index = std::max(0, std::min(index, int(sorted.size()) - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+qint64 LatencyStats::maxNs() const {
+    if (m_samples.isEmpty()) return 0;
+    return *std::max_element(m_samples.cbegin(), m_samples.cend());
+}
+
+QString LatencyStats::summary() const {
+    auto ms = [](qint64 ns) { return QString::number(ns / 1e6, 'f', 2); };
+    return QStringLiteral("n=%1 p50=%2ms p95=%3ms p99=%4ms max=%5ms")
+        .arg(m_totalSamples)
+        .arg(ms(percentileNs(50)), ms(percentileNs(95)), ms(percentileNs(99)), ms(maxNs()));
+}
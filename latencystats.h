@@ -0,0 +1,32 @@
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "constants.h"
+
+// Échantillons de latence (nanosecondes) conservés dans un tampon circulaire, avec calcul de percentiles.
+// Seuls les `capacity` derniers échantillons sont gardés, la mémoire reste donc bornée.
+class LatencyStats
+{
+public:
+    explicit LatencyStats(int capacity = LATENCY_SAMPLE_CAPACITY);
+
+    void addSample(qint64 ns);
+    void reset();
+
+    int count() const { return m_samples.size(); }
+    qint64 totalSamples() const { return m_totalSamples; }
+    qint64 percentileNs(double percentile) const; // percentile dans [0, 100]
+    qint64 maxNs() const;
+    QString summary() const; // "n=… p50=… p95=… p99=… max=…" en millisecondes
+
+private:
+    QVector<qint64> m_samples;
+    int m_capacity;
+    int m_next; // Prochaine case à écraser une fois le tampon plein
+    qint64 m_totalSamples;
+};
+
+#endif // LATENCYSTATS_H
@@ -0,0 +1,53 @@
+#include "levelgenerator.h"
+#include "constants.h"
+#include <QRandomGenerator>
+#include <algorithm>
+
+GeneratedLevel LevelGenerator::generate(quint32 seed, int width, int height) {
+    QRandomGenerator rng(seed);
+    GeneratedLevel level;
+    level.seed = seed;
+    level.size = QSize(width, height);
+
+    const int groundTop = height - LEVEL_GROUND_HEIGHT;
+
+    // --- Sol : segments séparés par des trous franchissables d'un saut ---
+    int x = 0;
+    bool firstSegment = true;
+    while (x < width) {
+        int length = rng.bounded(LEVEL_SEGMENT_MIN_LENGTH, LEVEL_SEGMENT_MAX_LENGTH + 1);
+        if (firstSegment) length = std::max(length, LEVEL_SPAWN_CLEARANCE); // Départ toujours sur du sol
+        length = std::min(length, width - x);
+        level.ground.append(QRect(x, groundTop, length, LEVEL_GROUND_HEIGHT));
+
+        // --- Ennemis répartis sur le segment (hors zone de départ) ---
+        int spawnX = x + rng.bounded(LEVEL_ENEMY_MIN_SPACING, LEVEL_ENEMY_MAX_SPACING + 1);
+        while (spawnX + ENEMY_WIDTH < x + length) {
+            if (spawnX > LEVEL_SPAWN_CLEARANCE) {
+                level.enemySpawns.append(QPoint(spawnX, groundTop - ENEMY_HEIGHT));
+            }
+            spawnX += rng.bounded(LEVEL_ENEMY_MIN_SPACING, LEVEL_ENEMY_MAX_SPACING + 1);
+        }
+
+        x += length + rng.bounded(LEVEL_GAP_MIN, LEVEL_GAP_MAX + 1);
+        firstSegment = false;
+    }
+
+    // --- Plateformes : une ou deux rangées, à hauteur de saut ---
+    x = LEVEL_SPAWN_CLEARANCE;
+    while (x < width) {
+        int platformWidth = rng.bounded(LEVEL_PLATFORM_MIN_WIDTH, LEVEL_PLATFORM_MAX_WIDTH + 1);
+        if (x + platformWidth > width) break;
+        int lift = rng.bounded(LEVEL_PLATFORM_MIN_LIFT, LEVEL_PLATFORM_MAX_LIFT + 1);
+        level.platforms.append(QRect(x, groundTop - lift, platformWidth, LEVEL_PLATFORM_HEIGHT));
+
+        // Seconde rangée occasionnelle, atteignable depuis la première
+        if (rng.bounded(100) < LEVEL_UPPER_PLATFORM_PERCENT && groundTop - 2 * lift > 0) {
+            level.platforms.append(QRect(x + platformWidth / 2, groundTop - 2 * lift, platformWidth, LEVEL_PLATFORM_HEIGHT));
+        }
+        x += platformWidth + rng.bounded(LEVEL_PLATFORM_MIN_SPACING, LEVEL_PLATFORM_MAX_SPACING + 1);
+    }
+
+    level.playerSpawn = QPoint(LEVEL_SPAWN_X, groundTop - MARIO_HEIGHT - LEVEL_SPAWN_DROP);
+    return level;
+}
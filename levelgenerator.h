@@ -0,0 +1,28 @@
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+#include <QtGlobal>
+
+// Description d'un niveau : géométrie solide, apparitions d'ennemis et point de départ du joueur
+struct GeneratedLevel {
+    QSize size;
+    QVector<QRect> ground;    // Segments de sol (séparés par des trous)
+    QVector<QRect> platforms; // Plateformes en hauteur
+    QVector<QPoint> enemySpawns; // Coin supérieur gauche de chaque ennemi
+    QPoint playerSpawn;
+    quint32 seed = 0;
+};
+
+// Générateur procédural déterministe : une même graine produit toujours le même niveau.
+// Sert aux tests de charge (niveaux très longs, plateformes denses, beaucoup d'ennemis).
+class LevelGenerator
+{
+public:
+    static GeneratedLevel generate(quint32 seed, int width, int height);
+};
+
+#endif // LEVELGENERATOR_H
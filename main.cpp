@@ -1,9 +1,127 @@
 #include "mainwindow.h"
+#include "metricsexporter.h"
+#include "framecapture.h"
+#include "soaktest.h"
+#include "constants.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QThread>
+#include <cstring>
+
+namespace {
+
+// Mode capture : simulation pas à pas aussi vite que possible, chaque image rendue hors écran
+int runCapture(FrameCapture::Options options, int frameCount)
+{
+    MainWindow w;
+    // Fenêtre "affichée" sans apparaître à l'écran : les widgets sont visibles, donc collisions et rendu
+    // se comportent comme en jeu
+    w.setAttribute(Qt::WA_DontShowOnScreen);
+    w.show();
+    w.setManualStepping(true);
+    options.frameSize = w.size();
+
+    FrameCapture capture(options);
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (int frame = 0; frame < frameCount; ++frame) {
+        w.stepSimulation();
+        QImage* buffer = capture.acquireBuffer();
+        w.renderFrame(*buffer);
+        capture.submit(buffer, frame);
+    }
+    capture.finish();
+
+    double seconds = elapsed.nsecsElapsed() / 1e9;
+    double realtimeSeconds = frameCount * TICK_INTERVAL_MS / 1000.0;
+    qDebug().noquote() << QStringLiteral("Capture: %1 images écrites (%2 échecs) en %3 s, %4x le temps réel")
+                              .arg(capture.framesWritten()).arg(capture.failures())
+                              .arg(seconds, 0, 'f', 2)
+                              .arg(seconds > 0 ? realtimeSeconds / seconds : 0.0, 0, 'f', 1);
+    return capture.failures() == 0 ? 0 : 1;
+}
+
+// Lit une option entière strictement positive ; signale l'erreur et retourne false sinon
+bool parsePositive(const QCommandLineParser& parser, const QCommandLineOption& option, int& value)
+{
+    bool ok = false;
+    value = parser.value(option).toInt(&ok);
+    if (!ok || value <= 0) {
+        qWarning() << "ERREUR: Valeur invalide pour l'option" << option.names().first() << ":" << parser.value(option) << "(entier > 0 attendu)";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
 
 int main(int argc, char *argv[])
 {
+    // Capture et soak n'ont pas besoin d'écran : plateforme offscreen sauf choix explicite de l'utilisateur
+    for (int i = 1; i < argc; ++i) {
+        bool headless = std::strncmp(argv[i], "--capture", 9) == 0 || std::strcmp(argv[i], "--soak") == 0;
+        if (headless && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption captureOption(QStringLiteral("capture"), QStringLiteral("Rend le jeu hors écran dans <dossier> au lieu de l'afficher."), QStringLiteral("dossier"));
+    QCommandLineOption framesOption(QStringLiteral("frames"), QStringLiteral("Nombre d'images à capturer."), QStringLiteral("n"), QString::number(CAPTURE_DEFAULT_FRAMES));
+    QCommandLineOption formatOption(QStringLiteral("format"), QStringLiteral("Format des images capturées : png ou raw."), QStringLiteral("format"), QStringLiteral("png"));
+    QCommandLineOption encodersOption(QStringLiteral("encoders"), QStringLiteral("Nombre de threads d'encodage."), QStringLiteral("n"));
+    QCommandLineOption soakOption(QStringLiteral("soak"), QStringLiteral("Test d'endurance hors écran sur un niveau généré."));
+    QCommandLineOption soakSecondsOption(QStringLiteral("soak-seconds"), QStringLiteral("Durée du test d'endurance."), QStringLiteral("secondes"), QString::number(SOAK_DEFAULT_SECONDS));
+    QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Graine du niveau généré et des entrées aléatoires."), QStringLiteral("n"), QStringLiteral("1"));
+    QCommandLineOption levelWidthOption(QStringLiteral("level-width"), QStringLiteral("Largeur du niveau généré (pixels)."), QStringLiteral("px"), QString::number(LEVEL_DEFAULT_WIDTH));
+    parser.addOptions({captureOption, framesOption, formatOption, encodersOption, soakOption, soakSecondsOption, seedOption, levelWidthOption});
+    parser.process(a);
+
+    if (parser.isSet(captureOption)) {
+        FrameCapture::Options options;
+        options.outputDir = parser.value(captureOption);
+        if (!FrameCapture::parseFormat(parser.value(formatOption), options.format)) {
+            qWarning() << "ERREUR: Format de capture inconnu" << parser.value(formatOption) << "(png ou raw)";
+            return 1;
+        }
+        int frameCount = 0;
+        if (!parsePositive(parser, framesOption, frameCount)) {
+            return 1;
+        }
+        if (parser.isSet(encodersOption)) {
+            if (!parsePositive(parser, encodersOption, options.encoderThreads)) {
+                return 1;
+            }
+        } else {
+            options.encoderThreads = qMax(1, QThread::idealThreadCount() - 1); // Un cœur reste au rendu
+        }
+        options.bufferCount = options.encoderThreads * CAPTURE_BUFFERS_PER_ENCODER;
+        return runCapture(options, frameCount);
+    }
+
+    if (parser.isSet(soakOption)) {
+        SoakTest::Options options;
+        int seed = 0;
+        if (!parsePositive(parser, soakSecondsOption, options.durationSeconds)
+            || !parsePositive(parser, seedOption, seed)
+            || !parsePositive(parser, levelWidthOption, options.levelWidth)) {
+            return 1;
+        }
+        options.seed = quint32(seed);
+        return SoakTest(options).run();
+    }
+
+    // Les compteurs sont publiés depuis un thread dédié, hors du chemin de rendu.
+    // Pas d'export en capture ni en soak : ces exécutions ne doivent pas occuper la socket du jeu interactif
+    MetricsExporter metricsExporter(qEnvironmentVariable("JR_GAME_METRICS_SOCKET", QString::fromLatin1(METRICS_SOCKET_NAME)));
+    metricsExporter.start();
+
     MainWindow w;
     w.show();
     return a.exec();
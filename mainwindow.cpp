@@ -1,14 +1,28 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "player.h"
+#include "metrics.h"
+#include "hud.h"
+#include "enemy.h"
 #include <QKeyEvent>
 #include <QWidget>
 #include <QPalette>
+#include <QDebug>
+#include <QTimer>
+#include <QMenuBar>
+#include <QImage>
+#include <QEvent>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , m_player(nullptr)
+    , m_hud(nullptr)
+    , m_levelClock(new QTimer(this))
+    , m_timeRemaining(LEVEL_TIME_SECONDS)
+    , m_simulatedMs(0)
+    , m_world(nullptr)
 {
     ui->setupUi(this);
     setMinimumSize(600, 300);
@@ -18,16 +32,136 @@ MainWindow::MainWindow(QWidget *parent)
     int playerInitialY = height() - m_player->height() - 150;
     int playerInitialX = 50;
     m_player->move(playerInitialX, playerInitialY);
+    m_playerSpawn = m_player->pos();
 
     setupObstacles();
+    rebuildOccupancy();
+    m_player->setOccupancyGrid(&m_occupancy);
+    m_player->setInputBuffer(&m_input);
     m_player->setObstacles(m_obstaclesList); // Doit être appelé APRES la création des obstacles
     m_player->show();
 
+    setupHud(); // Après le joueur et les obstacles pour rester au premier plan
+
+    publishEntityCount();
+
     setFocusPolicy(Qt::StrongFocus);
     setFocus();
 }
 
-MainWindow::~MainWindow() { delete ui; }
+MainWindow::~MainWindow() {
+    if (m_player && m_player->inputLatency().totalSamples() > 0) {
+        qDebug() << "Latence entrée -> dessin:" << m_player->inputLatency().summary();
+    }
+    delete ui;
+}
+
+void MainWindow::setManualStepping(bool manual) {
+    m_player->setTickTimerEnabled(!manual);
+    if (manual) {
+        m_levelClock->stop();
+    } else {
+        m_levelClock->start(1000);
+    }
+}
+
+void MainWindow::stepSimulation() {
+    m_player->step();
+
+    // Le décompte suit le temps simulé, pas l'horloge murale
+    m_simulatedMs += TICK_INTERVAL_MS;
+    while (m_simulatedMs >= 1000) {
+        m_simulatedMs -= 1000;
+        tickLevelClock();
+    }
+}
+
+void MainWindow::renderFrame(QImage& target) {
+    render(&target); // Fond + tous les widgets enfants (obstacles, joueur, HUD)
+}
+
+void MainWindow::loadLevel(const GeneratedLevel& level) {
+    qDeleteAll(m_obstaclesList);
+    m_obstaclesList.clear();
+    qDeleteAll(m_enemies);
+    m_enemies.clear();
+
+    // Le niveau est plus large que la fenêtre : il vit dans un conteneur déplacé par la caméra
+    if (!m_world) {
+        m_world = new QWidget(this);
+        m_player->setParent(m_world); // setParent() masque le widget, réaffiché plus bas
+        m_player->installEventFilter(this); // Chaque déplacement du joueur met à jour la caméra
+    }
+    m_world->setGeometry(0, 0, level.size.width(), level.size.height());
+
+    m_obstaclesList.reserve(level.ground.size() + level.platforms.size());
+    for (const QRect& rect : level.ground) {
+        m_obstaclesList.append(createObstacle(m_world, rect, Qt::darkYellow));
+    }
+    for (const QRect& rect : level.platforms) {
+        m_obstaclesList.append(createObstacle(m_world, rect, Qt::darkGreen));
+    }
+    m_enemies.reserve(level.enemySpawns.size());
+    for (const QPoint& spawn : level.enemySpawns) {
+        Enemy* enemy = new Enemy(":/images/goomba.png", QSize(GOOMBA_FRAME_WIDTH, GOOMBA_FRAME_HEIGHT), m_world);
+        enemy->move(spawn);
+        enemy->show();
+        m_enemies.append(enemy);
+    }
+
+    rebuildOccupancy();
+    m_player->setObstacles(m_obstaclesList);
+    m_playerSpawn = level.playerSpawn;
+    respawnPlayer();
+    m_player->show();
+
+    m_world->lower(); // Sous le HUD
+    m_world->show();
+    updateCamera();
+    publishEntityCount();
+}
+
+void MainWindow::respawnPlayer() {
+    m_player->resetAt(m_playerSpawn);
+}
+
+bool MainWindow::isPlayerAtLevelEnd() const {
+    QWidget* parent = m_player->parentWidget();
+    return parent && m_player->geometry().right() >= parent->width() - 1;
+}
+
+bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == m_player && event->type() == QEvent::Move) {
+        updateCamera();
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
+// Centre la caméra sur le joueur, sans sortir des bords du niveau
+void MainWindow::updateCamera() {
+    if (!m_world) return;
+    int maxOffset = std::max(0, m_world->width() - width());
+    int cameraX = std::clamp(m_player->x() + m_player->width() / 2 - width() / 2, 0, maxOffset);
+    if (m_world->x() != -cameraX) {
+        m_world->move(-cameraX, 0);
+    }
+}
+
+void MainWindow::publishEntityCount() {
+    MetricsRegistry::instance()
+        .gauge(QStringLiteral("jrgame_entities"), QStringLiteral("Entités présentes dans la scène (joueur, obstacles, ennemis)"))
+        ->set(1 + m_obstaclesList.size() + m_enemies.size());
+}
+
+QWidget* MainWindow::createObstacle(QWidget* parent, const QRect& geometry, const QColor& color) {
+    QWidget* obstacle = new QWidget(parent);
+    obstacle->setFixedSize(geometry.size());
+    obstacle->move(geometry.topLeft());
+    QPalette pal = obstacle->palette();
+    pal.setColor(QPalette::Window, color);
+    obstacle->setAutoFillBackground(true); obstacle->setPalette(pal); obstacle->show();
+    return obstacle;
+}
 
 void MainWindow::setupObstacles() {
     // Obstacle 1: Mur
@@ -58,27 +192,57 @@ void MainWindow::setupObstacles() {
     // m_obstaclesList.append(ground); // Ajouter si on veut un sol physique
 }
 
+void MainWindow::setupHud() {
+    m_hud = new Hud(this);
+    m_hud->move(0, menuBar()->height());
+    m_hud->setScore(0);
+    m_hud->setCoins(0);
+    m_hud->setTimeRemaining(m_timeRemaining);
+    m_hud->show();
+
+    connect(m_levelClock, &QTimer::timeout, this, &MainWindow::tickLevelClock);
+    m_levelClock->start(1000);
+}
+
+void MainWindow::tickLevelClock() {
+    if (m_timeRemaining > 0) {
+        --m_timeRemaining;
+        m_hud->setTimeRemaining(m_timeRemaining); // Ne redessine que le compteur de temps
+    }
+}
+
+void MainWindow::rebuildOccupancy() {
+    QVector<QRect> solids;
+    solids.reserve(m_obstaclesList.size());
+    for (const QWidget* obstacle : m_obstaclesList) {
+        // isHidden() et non isVisible() : la fenêtre n'est pas encore affichée à la construction
+        if (obstacle && !obstacle->isHidden()) {
+            solids.append(obstacle->geometry());
+        }
+    }
+    m_occupancy.rebuild(solids);
+}
+
 void MainWindow::keyPressEvent(QKeyEvent *event) {
     if (event->isAutoRepeat() || !m_player) {
         event->ignore();
         return;
     }
 
+    // Les touches sont horodatées et mises en file ; le joueur les applique au début de son prochain tick
     switch (event->key()) {
     case Qt::Key_Left:
-        m_player->startMoving(Player::Direction::Left);
+        m_input.push(InputBuffer::Action::MoveLeft, true);
         event->accept();
         break;
     case Qt::Key_Right:
-        m_player->startMoving(Player::Direction::Right);
+        m_input.push(InputBuffer::Action::MoveRight, true);
         event->accept();
         break;
-    // --- AJOUT : Touche pour sauter ---
     case Qt::Key_Space: // Ou Qt::Key_Up si vous préférez
-        m_player->jump();
+        m_input.push(InputBuffer::Action::Jump, true);
         event->accept();
         break;
-    // --- FIN AJOUT ---
     default:
         QMainWindow::keyPressEvent(event);
     }
@@ -90,24 +254,19 @@ void MainWindow::keyReleaseEvent(QKeyEvent *event) {
         return;
     }
 
-    Player::Direction currentMoveDirection = m_player->getCurrentDirection();
-
     switch (event->key()) {
     case Qt::Key_Left:
-        if (currentMoveDirection == Player::Direction::Left) {
-            m_player->stopMoving();
-        }
+        // Le joueur ne s'arrête que si c'était sa direction courante (géré dans Player::processInput)
+        m_input.push(InputBuffer::Action::MoveLeft, false);
         event->accept();
         break;
     case Qt::Key_Right:
-        if (currentMoveDirection == Player::Direction::Right) {
-            m_player->stopMoving();
-        }
+        m_input.push(InputBuffer::Action::MoveRight, false);
         event->accept();
         break;
-    // Le relâchement de la touche de saut n'a généralement pas d'effet ici
     case Qt::Key_Space: // Ou Qt::Key_Up
-        event->accept(); // Accepter l'événement même si on ne fait rien
+        m_input.push(InputBuffer::Action::Jump, false);
+        event->accept();
         break;
     default:
         QMainWindow::keyReleaseEvent(event);
@@ -4,12 +4,20 @@
 #include <QMainWindow>
 #include <QList> // Ajout pour QList
 #include "player.h" // Pour Player::Direction
+#include "occupancygrid.h"
+#include "inputbuffer.h"
+#include "levelgenerator.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
 class QKeyEvent;
+class QImage;
+class QColor;
+class QTimer;
+class Hud;
+class Enemy;
 class QWidget; // Déclaration anticipée pour la liste d'obstacles
 
 class MainWindow : public QMainWindow
@@ -20,15 +28,42 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    // --- Simulation pas à pas (capture, tests) ---
+    void setManualStepping(bool manual); // Coupe les timers : la simulation n'avance que via stepSimulation()
+    void stepSimulation(); // Un tick de simulation (TICK_INTERVAL_MS de temps simulé)
+    void renderFrame(QImage& target); // Dessine la scène complète dans une image existante
+
+    // --- Niveaux générés ---
+    void loadLevel(const GeneratedLevel& level); // Remplace les obstacles ; la caméra suit ensuite le joueur
+    void respawnPlayer();
+    bool isPlayerAtLevelEnd() const;
+    InputBuffer& inputBuffer() { return m_input; } // Pour injecter des entrées scriptées
+
 protected:
     void keyPressEvent(QKeyEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 private:
     void setupObstacles(); // Méthode pour créer les obstacles
+    void rebuildOccupancy(); // Reconstruit la grille d'occupation à partir des obstacles
+    void setupHud();
+    void tickLevelClock(); // Décompte du temps restant, une fois par seconde
+    QWidget* createObstacle(QWidget* parent, const QRect& geometry, const QColor& color);
+    void updateCamera();
+    void publishEntityCount();
 
     Ui::MainWindow *ui;
     Player* m_player;
     QList<QWidget*> m_obstaclesList; // Liste pour stocker les obstacles
+    OccupancyGrid m_occupancy; // Grille solide du niveau, partagée par toutes les entités
+    InputBuffer m_input; // Entrées clavier horodatées, consommées par le tick du joueur
+    Hud* m_hud;
+    QTimer* m_levelClock;
+    int m_timeRemaining;
+    int m_simulatedMs; // Temps simulé accumulé vers la prochaine seconde du décompte (mode manuel)
+    QWidget* m_world; // Conteneur des niveaux générés (plus large que la fenêtre), nullptr sinon
+    QList<Enemy*> m_enemies;
+    QPoint m_playerSpawn;
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,119 @@
+#include "metrics.h"
+#include "processstats.h"
+#include <QLocale>
+#include <QMutexLocker>
+#include <algorithm>
+
+namespace {
+
+// Représentation la plus courte qui relit la même valeur : 0.05 et non 0.050000000000000003
+QByteArray formatValue(double value) {
+    return QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+}
+
+} // namespace
+
+// --- MetricHistogram ---
+
+MetricHistogram::MetricHistogram(const QVector<double>& upperBounds)
+    : m_upperBounds(upperBounds),
+    m_buckets(new std::atomic<quint64>[upperBounds.size() + 1])
+{
+    std::sort(m_upperBounds.begin(), m_upperBounds.end());
+    for (int i = 0; i <= m_upperBounds.size(); ++i) {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double value) {
+    int index = std::lower_bound(m_upperBounds.cbegin(), m_upperBounds.cend(), value) - m_upperBounds.cbegin();
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    double sum = m_sum.load(std::memory_order_relaxed);
+    while (!m_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+    }
+}
+
+quint64 MetricHistogram::bucketCount(int index) const {
+    return m_buckets[index].load(std::memory_order_relaxed);
+}
+
+// --- MetricsRegistry ---
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Family* MetricsRegistry::findOrCreate(const QString& name, const QString& help) {
+    for (const auto& family : m_families) {
+        if (family->name == name) return family.get();
+    }
+    m_families.push_back(std::unique_ptr<Family>(new Family{name, help, nullptr, nullptr, nullptr}));
+    return m_families.back().get();
+}
+
+MetricCounter* MetricsRegistry::counter(const QString& name, const QString& help) {
+    QMutexLocker locker(&m_mutex);
+    Family* family = findOrCreate(name, help);
+    if (!family->counter) family->counter.reset(new MetricCounter);
+    return family->counter.get();
+}
+
+MetricGauge* MetricsRegistry::gauge(const QString& name, const QString& help) {
+    QMutexLocker locker(&m_mutex);
+    Family* family = findOrCreate(name, help);
+    if (!family->gauge) family->gauge.reset(new MetricGauge);
+    return family->gauge.get();
+}
+
+MetricHistogram* MetricsRegistry::histogram(const QString& name, const QString& help, const QVector<double>& upperBounds) {
+    QMutexLocker locker(&m_mutex);
+    Family* family = findOrCreate(name, help);
+    if (!family->histogram) family->histogram.reset(new MetricHistogram(upperBounds));
+    return family->histogram.get();
+}
+
+QByteArray MetricsRegistry::renderPrometheus() const {
+    QByteArray out;
+    out.reserve(4096);
+
+    auto header = [&out](const QByteArray& name, const QString& help, const char* type) {
+        out += "# HELP " + name + ' ' + help.toUtf8() + '\n';
+        out += "# TYPE " + name + ' ' + type + '\n';
+    };
+
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const auto& family : m_families) {
+            const QByteArray name = family->name.toUtf8();
+            if (family->counter) {
+                header(name, family->help, "counter");
+                out += name + ' ' + QByteArray::number(family->counter->value()) + '\n';
+            } else if (family->gauge) {
+                header(name, family->help, "gauge");
+                out += name + ' ' + formatValue(family->gauge->value()) + '\n';
+            } else if (family->histogram) {
+                const MetricHistogram& histogram = *family->histogram;
+                header(name, family->help, "histogram");
+                quint64 cumulative = 0;
+                for (int i = 0; i < histogram.upperBounds().size(); ++i) {
+                    cumulative += histogram.bucketCount(i);
+                    out += name + "_bucket{le=\"" + formatValue(histogram.upperBounds().at(i)) + "\"} "
+                        + QByteArray::number(cumulative) + '\n';
+                }
+                cumulative += histogram.bucketCount(histogram.upperBounds().size());
+                out += name + "_bucket{le=\"+Inf\"} " + QByteArray::number(cumulative) + '\n';
+                out += name + "_sum " + formatValue(histogram.sum()) + '\n';
+                out += name + "_count " + QByteArray::number(cumulative) + '\n';
+            }
+        }
+    }
+
+    qint64 rss = ProcessStats::residentMemoryBytes(); // Lue au moment de l'export
+    if (rss >= 0) {
+        header("process_resident_memory_bytes", QStringLiteral("Mémoire résidente du processus"), "gauge");
+        out += "process_resident_memory_bytes " + QByteArray::number(rss) + '\n';
+    }
+    return out;
+}
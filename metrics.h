@@ -0,0 +1,87 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Métriques d'exécution (compteurs, jauges, histogrammes) mises à jour depuis les chemins chauds
+// avec des atomiques relaxés : aucune synchronisation côté jeu, lecture concurrente par l'exportateur.
+
+class MetricCounter
+{
+public:
+    void inc(quint64 n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    quint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> m_value{0};
+};
+
+class MetricGauge
+{
+public:
+    void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    double value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value{0.0};
+};
+
+class MetricHistogram
+{
+public:
+    explicit MetricHistogram(const QVector<double>& upperBounds); // Bornes croissantes, "+Inf" implicite
+
+    void observe(double value);
+
+    const QVector<double>& upperBounds() const { return m_upperBounds; }
+    quint64 bucketCount(int index) const; // Non cumulé ; index == upperBounds().size() pour +Inf
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    double sum() const { return m_sum.load(std::memory_order_relaxed); }
+
+private:
+    QVector<double> m_upperBounds;
+    std::unique_ptr<std::atomic<quint64>[]> m_buckets;
+    std::atomic<quint64> m_count{0};
+    std::atomic<double> m_sum{0.0};
+};
+
+// Registre global. L'enregistrement est rare (au démarrage) et protégé par un mutex ;
+// les pointeurs retournés restent valides pendant toute la durée du programme.
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& instance();
+
+    MetricCounter* counter(const QString& name, const QString& help);
+    MetricGauge* gauge(const QString& name, const QString& help);
+    MetricHistogram* histogram(const QString& name, const QString& help, const QVector<double>& upperBounds);
+
+    QByteArray renderPrometheus() const; // Format texte d'exposition Prometheus
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    struct Family {
+        QString name;
+        QString help;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+    };
+
+    Family* findOrCreate(const QString& name, const QString& help); // Appelant : m_mutex verrouillé
+
+    mutable QMutex m_mutex;
+    std::vector<std::unique_ptr<Family>> m_families;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,93 @@
+#include "metricsexporter.h"
+#include "metrics.h"
+#include "constants.h"
+#include <QDebug>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTimer>
+
+// --- MetricsServer ---
+
+MetricsServer::MetricsServer(const QString& socketName, QObject* parent)
+    : QObject(parent),
+    m_socketName(socketName),
+    m_server(nullptr)
+{
+}
+
+void MetricsServer::listen() {
+    m_server = new QLocalServer(this);
+    bool listening = m_server->listen(m_socketName);
+    if (!listening && m_server->serverError() == QAbstractSocket::AddressInUseError && !isServerAlive(m_socketName)) {
+        // Socket orpheline d'une exécution précédente : personne ne répond, on peut la supprimer
+        QLocalServer::removeServer(m_socketName);
+        listening = m_server->listen(m_socketName);
+    }
+    if (!listening) {
+        qWarning() << "ERREUR: Impossible d'ouvrir la socket de métriques" << m_socketName << ":" << m_server->errorString();
+        return;
+    }
+    connect(m_server, &QLocalServer::newConnection, this, &MetricsServer::handleNewConnection);
+}
+
+// Vrai si une autre instance écoute déjà sur cette socket (on ne doit pas la lui retirer)
+bool MetricsServer::isServerAlive(const QString& socketName) {
+    QLocalSocket probe;
+    probe.connectToServer(socketName);
+    bool alive = probe.waitForConnected(METRICS_PROBE_TIMEOUT_MS);
+    probe.abort();
+    return alive;
+}
+
+void MetricsServer::handleNewConnection() {
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+
+        // Un client HTTP envoie sa requête tout de suite ; un simple lecteur (socat, nc) n'envoie rien
+        connect(socket, &QLocalSocket::readyRead, socket, [this, socket]() {
+            if (socket->property("answered").toBool()) return;
+            respond(socket, socket->peek(4) == "GET ");
+        });
+        QTimer::singleShot(METRICS_PLAIN_REPLY_DELAY_MS, socket, [this, socket]() {
+            if (!socket->property("answered").toBool()) respond(socket, false);
+        });
+    }
+}
+
+void MetricsServer::respond(QLocalSocket* socket, bool http) {
+    socket->setProperty("answered", true);
+    const QByteArray body = MetricsRegistry::instance().renderPrometheus();
+    if (http) {
+        socket->write("HTTP/1.0 200 OK\r\n"
+                      "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                      "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                      "Connection: close\r\n\r\n");
+    }
+    socket->write(body);
+    socket->disconnectFromServer(); // Attend l'envoi des données en attente avant de fermer
+}
+
+// --- MetricsExporter ---
+
+MetricsExporter::MetricsExporter(const QString& socketName)
+    : m_socketName(socketName),
+    m_server(new MetricsServer(socketName))
+{
+    m_server->moveToThread(&m_thread);
+    QObject::connect(&m_thread, &QThread::started, m_server, &MetricsServer::listen);
+    QObject::connect(&m_thread, &QThread::finished, m_server, &QObject::deleteLater);
+    m_thread.setObjectName(QStringLiteral("metrics-exporter"));
+}
+
+MetricsExporter::~MetricsExporter() {
+    if (!m_thread.isRunning()) {
+        delete m_server; // Jamais démarré : pas de signal finished() pour le détruire
+        return;
+    }
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void MetricsExporter::start() {
+    m_thread.start(QThread::LowPriority);
+}
@@ -0,0 +1,51 @@
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+class QLocalServer;
+class QLocalSocket;
+
+// Serveur de métriques : vit dans le thread d'export, jamais dans le thread GUI.
+// Chaque connexion reçoit un instantané au format texte Prometheus (en HTTP si le client envoie un GET).
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsServer(const QString& socketName, QObject* parent = nullptr);
+
+public slots:
+    void listen();
+
+private slots:
+    void handleNewConnection();
+
+private:
+    static bool isServerAlive(const QString& socketName);
+    void respond(QLocalSocket* socket, bool http);
+
+    QString m_socketName;
+    QLocalServer* m_server;
+};
+
+// Publie le registre de métriques sur une socket locale (Unix) depuis un thread dédié,
+// pour que les agents de supervision puissent lire les compteurs sans toucher au temps de frame.
+class MetricsExporter
+{
+public:
+    explicit MetricsExporter(const QString& socketName);
+    ~MetricsExporter();
+
+    void start();
+    QString socketName() const { return m_socketName; }
+
+private:
+    QString m_socketName;
+    QThread m_thread;
+    MetricsServer* m_server;
+};
+
+#endif // METRICSEXPORTER_H
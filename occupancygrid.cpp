@@ -0,0 +1,187 @@
+#include "occupancygrid.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OCCUPANCY_USE_SSE2 1
+#endif
+
+namespace {
+
+// Masque des bits [first, 63] d'un mot
+inline quint64 headMask(int first) { return ~quint64(0) << (first & 63); }
+// Masque des bits [0, last] d'un mot
+inline quint64 tailMask(int last) { return ~quint64(0) >> (63 - (last & 63)); }
+
+// Vrai si au moins un bit est à 1 parmi `count` mots consécutifs
+inline bool anyBitSet(const quint64* words, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (words[i]) return true;
+    }
+    return false;
+}
+
+// Vrai si au moins un bit de [first, last] est à 1 (bits numérotés depuis words[0]).
+// Une boîte de collision couvre au plus deux mots : avec SSE2, c'est un seul test 128 bits masqué.
+// Le mot qui suit le dernier mot utile doit être lisible (voir le mot de bourrage des lignes).
+inline bool spanAny(const quint64* words, int first, int last) {
+    int firstWord = first >> 6;
+    int lastWord = last >> 6;
+#ifdef OCCUPANCY_USE_SSE2
+    if (lastWord - firstWord <= 1) {
+        quint64 low = headMask(first);
+        quint64 high = 0;
+        if (firstWord == lastWord) {
+            low &= tailMask(last);
+        } else {
+            high = tailMask(last);
+        }
+        const __m128i mask = _mm_set_epi64x(qint64(high), qint64(low));
+        const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + firstWord));
+        const __m128i hit = _mm_and_si128(bits, mask);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(hit, _mm_setzero_si128())) != 0xFFFF;
+    }
+#endif
+    if (firstWord == lastWord) {
+        return words[firstWord] & headMask(first) & tailMask(last);
+    }
+    if (words[firstWord] & headMask(first)) return true;
+    if (words[lastWord] & tailMask(last)) return true;
+    return anyBitSet(words + firstWord + 1, lastWord - firstWord - 1);
+}
+
+// Met à 1 les bits [first, last]
+inline void fillSpan(quint64* words, int first, int last) {
+    int firstWord = first >> 6;
+    int lastWord = last >> 6;
+    if (firstWord == lastWord) {
+        words[firstWord] |= headMask(first) & tailMask(last);
+        return;
+    }
+    words[firstWord] |= headMask(first);
+    for (int w = firstWord + 1; w < lastWord; ++w) {
+        words[w] = ~quint64(0);
+    }
+    words[lastWord] |= tailMask(last);
+}
+
+// Mots par ligne de bits : un mot de bourrage pour la lecture 128 bits de spanAny()
+inline int strideFor(int bits) { return (bits + 63) / 64 + 1; }
+
+} // namespace
+
+OccupancyGrid::OccupancyGrid()
+    : m_columns(0),
+    m_rows(0),
+    m_wordsPerRow(0),
+    m_wordsPerColumn(0)
+{
+}
+
+// --- Construction ---
+
+void OccupancyGrid::rebuild(const QVector<QRect>& solids) {
+    clear();
+
+    // La grille couvre (0, 0) jusqu'au coin inférieur droit du solide le plus éloigné
+    int maxRight = 0;
+    int maxBottom = 0;
+    for (const QRect& rect : solids) {
+        if (rect.isEmpty()) continue;
+        maxRight = std::max(maxRight, rect.right() + 1);
+        maxBottom = std::max(maxBottom, rect.bottom() + 1);
+    }
+    if (maxRight <= 0 || maxBottom <= 0) return;
+
+    m_columns = maxRight;
+    m_rows = maxBottom;
+    m_wordsPerRow = strideFor(m_columns);
+    m_wordsPerColumn = strideFor(m_rows);
+    m_bits.assign(size_t(m_rows) * m_wordsPerRow, 0);
+    m_columnBits.assign(size_t(m_columns) * m_wordsPerColumn, 0);
+
+    for (const QRect& rect : solids) {
+        fillRect(rect);
+    }
+}
+
+void OccupancyGrid::clear() {
+    m_columns = 0;
+    m_rows = 0;
+    m_wordsPerRow = 0;
+    m_wordsPerColumn = 0;
+    m_bits.clear();
+    m_columnBits.clear();
+}
+
+// Marque comme solides tous les pixels du rectangle, dans les deux copies
+void OccupancyGrid::fillRect(const QRect& rect) {
+    QRect clipped = rect.intersected(bounds());
+    if (clipped.isEmpty()) return;
+
+    for (int row = clipped.top(); row <= clipped.bottom(); ++row) {
+        fillSpan(m_bits.data() + size_t(row) * m_wordsPerRow, clipped.left(), clipped.right());
+    }
+    for (int column = clipped.left(); column <= clipped.right(); ++column) {
+        fillSpan(m_columnBits.data() + size_t(column) * m_wordsPerColumn, clipped.top(), clipped.bottom());
+    }
+}
+
+// --- Requêtes ---
+
+bool OccupancyGrid::rowAny(int row, int firstColumn, int lastColumn) const {
+    return spanAny(rowData(row), firstColumn, lastColumn);
+}
+
+bool OccupancyGrid::columnAny(int column, int firstRow, int lastRow) const {
+    return spanAny(columnData(column), firstRow, lastRow);
+}
+
+bool OccupancyGrid::isSolid(int x, int y) const {
+    return spanSolid(x, x, y);
+}
+
+bool OccupancyGrid::spanSolid(int left, int right, int y) const {
+    return rectSolid(QRect(QPoint(left, y), QPoint(right, y)));
+}
+
+bool OccupancyGrid::rectSolid(const QRect& rect) const {
+    return firstSolidRow(rect) >= 0;
+}
+
+int OccupancyGrid::firstSolidRow(const QRect& rect) const {
+    QRect clipped = rect.intersected(bounds());
+    if (clipped.isEmpty()) return -1;
+    for (int row = clipped.top(); row <= clipped.bottom(); ++row) {
+        if (rowAny(row, clipped.left(), clipped.right())) return row;
+    }
+    return -1;
+}
+
+int OccupancyGrid::lastSolidRow(const QRect& rect) const {
+    QRect clipped = rect.intersected(bounds());
+    if (clipped.isEmpty()) return -1;
+    for (int row = clipped.bottom(); row >= clipped.top(); --row) {
+        if (rowAny(row, clipped.left(), clipped.right())) return row;
+    }
+    return -1;
+}
+
+// Les murs se lisent dans la copie en colonnes : un test par colonne balayée, quelle que soit la hauteur
+int OccupancyGrid::firstSolidColumn(const QRect& rect) const {
+    QRect clipped = rect.intersected(bounds());
+    if (clipped.isEmpty()) return -1;
+    for (int column = clipped.left(); column <= clipped.right(); ++column) {
+        if (columnAny(column, clipped.top(), clipped.bottom())) return column;
+    }
+    return -1;
+}
+
+int OccupancyGrid::lastSolidColumn(const QRect& rect) const {
+    QRect clipped = rect.intersected(bounds());
+    if (clipped.isEmpty()) return -1;
+    for (int column = clipped.right(); column >= clipped.left(); --column) {
+        if (columnAny(column, clipped.top(), clipped.bottom())) return column;
+    }
+    return -1;
+}
@@ -0,0 +1,53 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <QRect>
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+
+// Grille d'occupation binaire du niveau : 1 bit par pixel, 1 si le pixel est solide.
+// La résolution est volontairement le pixel : les réponses sont exactes (pas de faux positifs au bord
+// d'une plateforme), ce qui permet de résoudre les collisions sans revenir à la géométrie des obstacles.
+// Le masque est stocké deux fois, par rangées (sols, plafonds) et par colonnes (murs), en mots de 64 bits :
+// une sonde de la taille d'une boîte de collision couvre au plus deux mots, testés en une instruction SSE2.
+// Coût mémoire : 2 x largeur x hauteur / 8 octets (~30 Mo pour un niveau de 200 000 x 600 px).
+// Tout ce qui est hors de la grille est vide.
+class OccupancyGrid
+{
+public:
+    OccupancyGrid();
+
+    // --- Construction ---
+    void rebuild(const QVector<QRect>& solids); // Reconstruit la grille à partir des rectangles solides
+    void clear();
+
+    // --- Requêtes ---
+    bool isSolid(int x, int y) const;
+    bool spanSolid(int left, int right, int y) const; // Bornes incluses
+    bool rectSolid(const QRect& rect) const;
+
+    // --- Bords bloquants dans un rectangle (-1 si aucun pixel solide) ---
+    int firstSolidRow(const QRect& rect) const;    // Rangée solide la plus haute
+    int lastSolidRow(const QRect& rect) const;     // Rangée solide la plus basse
+    int firstSolidColumn(const QRect& rect) const; // Colonne solide la plus à gauche
+    int lastSolidColumn(const QRect& rect) const;  // Colonne solide la plus à droite
+
+    QRect bounds() const { return QRect(0, 0, m_columns, m_rows); }
+
+private:
+    void fillRect(const QRect& rect);
+    bool rowAny(int row, int firstColumn, int lastColumn) const;
+    bool columnAny(int column, int firstRow, int lastRow) const;
+    const quint64* rowData(int row) const { return m_bits.data() + size_t(row) * m_wordsPerRow; }
+    const quint64* columnData(int column) const { return m_columnBits.data() + size_t(column) * m_wordsPerColumn; }
+
+    int m_columns;
+    int m_rows;
+    int m_wordsPerRow;
+    int m_wordsPerColumn;
+    std::vector<quint64> m_bits;       // Rangée par rangée
+    std::vector<quint64> m_columnBits; // Copie transposée, colonne par colonne
+};
+
+#endif // OCCUPANCYGRID_H
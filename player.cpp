@@ -1,4 +1,6 @@
 #include "player.h"
+#include "occupancygrid.h"
+#include "metrics.h"
 #include <QPainter>
 #include <QTimer>
 #include <QPaintEvent>
@@ -6,8 +8,41 @@
 #include <QDebug>
 #include <QWidget>
 #include <cmath>
+#include <algorithm>
 #include <QPointF>
 
+namespace {
+
+// Métriques du joueur, enregistrées une seule fois auprès du registre global
+struct PlayerMetrics {
+    MetricCounter* ticks;
+    MetricCounter* collisionQueries;
+    MetricCounter* framesPainted;
+    MetricHistogram* tickDurationSeconds;
+    MetricHistogram* paintDurationSeconds;
+    MetricHistogram* inputLatencySeconds;
+};
+
+const PlayerMetrics& metrics() {
+    static const PlayerMetrics playerMetrics = [] {
+        MetricsRegistry& registry = MetricsRegistry::instance();
+        // Unités de base Prometheus : secondes
+        const QVector<double> durationBuckets{0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.002, 0.004, 0.008, 0.016};
+        const QVector<double> latencyBuckets{0.004, 0.008, 0.016, 0.024, 0.033, 0.05, 0.066, 0.1, 0.2};
+        return PlayerMetrics{
+            registry.counter(QStringLiteral("jrgame_ticks_total"), QStringLiteral("Ticks de simulation exécutés")),
+            registry.counter(QStringLiteral("jrgame_collision_queries_total"), QStringLiteral("Requêtes de collision et de sol")),
+            registry.counter(QStringLiteral("jrgame_frames_painted_total"), QStringLiteral("Images dessinées")),
+            registry.histogram(QStringLiteral("jrgame_tick_duration_seconds"), QStringLiteral("Durée d'un tick de simulation"), durationBuckets),
+            registry.histogram(QStringLiteral("jrgame_paint_duration_seconds"), QStringLiteral("Durée du dessin du joueur"), durationBuckets),
+            registry.histogram(QStringLiteral("jrgame_input_latency_seconds"), QStringLiteral("Latence entrée -> dessin du joueur"), latencyBuckets),
+        };
+    }();
+    return playerMetrics;
+}
+
+} // namespace
+
 Player::Player(QWidget* parent)
     : QWidget(parent),
     m_currentFrame(MARIO_STANDING_FRAME),
@@ -19,11 +54,18 @@ Player::Player(QWidget* parent)
     m_currentDirection(Direction::None),
     m_facingDirection(Direction::Right),
     m_speed(MARIO_SPEED),
+    m_occupancy(nullptr),
     // Initialisation des membres de saut/gravité
     m_isJumpingOrFalling(false), // Commence au sol
-    m_velocityY(0.0)
+    m_velocityY(0.0),
+    m_input(nullptr),
+    m_jumpBufferTicks(msToTicks(JUMP_BUFFER_MS)),
+    m_coyoteTicks(msToTicks(COYOTE_TIME_MS)),
+    m_jumpBufferRemaining(0),
+    m_coyoteRemaining(0)
 {
-    if (!m_spritesheet.load(":/images/mario.png")) {
+    m_spritesheet = AssetCache::instance().pixmap(":/images/mario.png");
+    if (!m_spritesheet) {
         qWarning() << "ERREUR: Impossible de charger le spritesheet ':/images/mario.png'. Vérifiez le fichier de ressources (qrc).";
     }
 
@@ -31,7 +73,9 @@ Player::Player(QWidget* parent)
     connect(m_animationTimer, &QTimer::timeout, this, &Player::updateState);
 
     // Démarre le timer immédiatement car il gère maintenant aussi la gravité
-    m_animationTimer->start(16); // Environ 60 FPS (ajuster si besoin)
+    // PreciseTimer : limite la gigue du tick, qui s'ajoute directement à la latence perçue
+    m_animationTimer->setTimerType(Qt::PreciseTimer);
+    m_animationTimer->start(TICK_INTERVAL_MS); // Environ 60 FPS (ajuster si besoin)
 }
 
 void Player::setObstacles(const QList<QWidget*>& obstacles) {
@@ -42,6 +86,47 @@ void Player::setObstacles(const QList<QWidget*>& obstacles) {
     }
 }
 
+void Player::setOccupancyGrid(const OccupancyGrid* grid) {
+    m_occupancy = grid;
+}
+
+void Player::setInputBuffer(InputBuffer* input) {
+    m_input = input;
+}
+
+void Player::setJumpBufferMs(int ms) {
+    m_jumpBufferTicks = msToTicks(ms);
+}
+
+void Player::setCoyoteTimeMs(int ms) {
+    m_coyoteTicks = msToTicks(ms);
+}
+
+const LatencyStats& Player::inputLatency() const {
+    return m_inputLatency;
+}
+
+void Player::setTickTimerEnabled(bool enabled) {
+    if (enabled) {
+        m_animationTimer->start(TICK_INTERVAL_MS);
+    } else {
+        m_animationTimer->stop();
+    }
+}
+
+void Player::step() {
+    updateState();
+}
+
+void Player::resetAt(const QPoint& topLeft) {
+    move(topLeft);
+    m_currentDirection = Direction::None;
+    m_velocityY = 0.0;
+    m_jumpBufferRemaining = 0;
+    m_coyoteRemaining = 0;
+    m_isJumpingOrFalling = !isOnGround();
+}
+
 void Player::startMoving(Direction direction) {
     if (direction == Direction::None) return;
     m_currentDirection = direction;
@@ -56,12 +141,8 @@ void Player::stopMoving() {
 }
 
 void Player::jump() {
-    // Ne saute que si le joueur est sur le sol
-    if (!m_isJumpingOrFalling && isOnGround()) {
-        m_velocityY = JUMP_STRENGTH;
-        m_isJumpingOrFalling = true;
-        //qDebug() << "Jump! Initial velocity:" << m_velocityY;
-    }
+    // L'appui reste valable pendant la durée du buffer : si on atterrit entre-temps, le saut part quand même
+    m_jumpBufferRemaining = std::max(1, m_jumpBufferTicks);
 }
 
 Player::Direction Player::getCurrentDirection() const {
@@ -70,6 +151,56 @@ Player::Direction Player::getCurrentDirection() const {
 
 // --- Fonctions Helper ---
 
+int Player::msToTicks(int ms) {
+    if (ms <= 0) return 0;
+    return (ms + TICK_INTERVAL_MS - 1) / TICK_INTERVAL_MS;
+}
+
+// Applique les entrées reçues depuis le tick précédent
+void Player::processInput() {
+    if (!m_input) return;
+
+    const QVector<InputBuffer::Event> events = m_input->takeAll();
+    for (const InputBuffer::Event& event : events) {
+        const Direction previousDirection = m_currentDirection;
+        bool changedState = false;
+        switch (event.action) {
+        case InputBuffer::Action::MoveLeft:
+        case InputBuffer::Action::MoveRight: {
+            Direction direction = (event.action == InputBuffer::Action::MoveLeft) ? Direction::Left : Direction::Right;
+            if (event.pressed) {
+                startMoving(direction);
+            } else if (m_currentDirection == direction) {
+                stopMoving();
+            }
+            changedState = m_currentDirection != previousDirection;
+            break;
+        }
+        case InputBuffer::Action::Jump:
+            if (event.pressed) {
+                jump();
+                changedState = true;
+            }
+            break;
+        }
+        // Seules les entrées qui modifient la simulation ont un effet visible : les répétitions de touche
+        // et les relâchements sans effet fausseraient la latence entrée -> dessin
+        if (changedState) m_unpresentedInputs.append(event.timestampNs);
+    }
+}
+
+// Saute si on est au sol, ou si on l'a quitté depuis moins que le coyote time
+bool Player::tryStartJump() {
+    bool grounded = !m_isJumpingOrFalling && isOnGround();
+    if (!grounded && m_coyoteRemaining <= 0) {
+        return false;
+    }
+    m_velocityY = JUMP_STRENGTH;
+    m_isJumpingOrFalling = true;
+    m_coyoteRemaining = 0; // Pas de second saut pendant la même fenêtre
+    return true;
+}
+
 // Calcule le rectangle de collision pour une position donnée du *coin supérieur gauche* du widget
 QRect Player::getCollisionRect(const QPoint& futureTopLeft) const {
     int collisionX = futureTopLeft.x() + COLLISION_MARGIN_LEFT;
@@ -84,6 +215,7 @@ QRect Player::getCollisionRect(const QPoint& futureTopLeft) const {
 // Vérifie la collision et retourne l'obstacle touché (ou nullptr)
 bool Player::checkCollision(const QRect& futureCollisionRect, QWidget*& collidedObstacle) const {
     collidedObstacle = nullptr; // Initialise
+    metrics().collisionQueries->inc();
     for (QWidget* obstacle : m_obstacles) {
         if (obstacle && obstacle->isVisible() && futureCollisionRect.intersects(obstacle->geometry())) {
             collidedObstacle = obstacle;
@@ -121,6 +253,7 @@ bool Player::checkCollision(const QRect& futureCollisionRect, QWidget*& collided
 // Vérifie si le joueur repose sur une surface solide (version plus stricte)
 bool Player::isOnGround() const {
     if (!parentWidget()) return false;
+    metrics().collisionQueries->inc();
 
     // --- VERSION CORRIGÉE (Points sous la boîte de collision) ---
     int currentX = pos().x();
@@ -133,6 +266,13 @@ bool Player::isOnGround() const {
     // Coordonnée Y juste sous le bas de la boîte de collision
     int checkY = currentY + m_frameHeight - COLLISION_MARGIN_BOTTOM + 1; // +1 pixel en dessous
 
+    // Avec la grille (exacte au pixel) : toute la largeur de la boîte est testée en une seule requête de rangée,
+    // donc une plateforme plus étroite que le joueur est aussi détectée
+    if (m_occupancy) {
+        return checkY >= parentWidget()->height()
+            || m_occupancy->spanSolid(collisionX_Left, collisionX_Right, checkY);
+    }
+
     // Points à vérifier
     QPoint checkPointLeft(collisionX_Left, checkY);
     QPoint checkPointRight(collisionX_Right, checkY);
@@ -165,6 +305,7 @@ bool Player::isOnGround() const {
 // --- REFACTORISATION de updateState pour séparer X et Y ---
 void Player::updateState() {
     if (!parentWidget()) return;
+    qint64 tickStartNs = InputBuffer::nowNs();
 
     // --- Variables initiales ---
     int currentX = x();
@@ -174,6 +315,16 @@ void Player::updateState() {
     int parentWidth = parentWidget()->width();
     int parentHeight = parentWidget()->height();
 
+    // --- Phase 0: Entrées et saut bufferisé ---
+    processInput();
+    if (m_jumpBufferRemaining > 0) {
+        if (tryStartJump()) {
+            m_jumpBufferRemaining = 0;
+        } else {
+            --m_jumpBufferRemaining;
+        }
+    }
+
     // --- Phase 1: Mouvement Horizontal et Collision ---
     int deltaX = 0;
     if (m_currentDirection == Direction::Left) {
@@ -190,10 +341,14 @@ void Player::updateState() {
         if (tryX + m_frameWidth > parentWidth) tryX = parentWidth - m_frameWidth;
 
         // Vérifier collision horizontale avec les obstacles
-        QRect horizontalCheckRect = getCollisionRect(QPoint(tryX, currentY)); // Utilise Y actuel
-        QWidget* hObstacle = nullptr;
-        if (checkCollision(horizontalCheckRect, hObstacle)) {
-            resolveHorizontalCollision(hObstacle, tryX); // Ajuste tryX si collision
+        if (m_occupancy) {
+            resolveHorizontalCollisionOnGrid(currentX, currentY, tryX);
+        } else {
+            QRect horizontalCheckRect = getCollisionRect(QPoint(tryX, currentY)); // Utilise Y actuel
+            QWidget* hObstacle = nullptr;
+            if (checkCollision(horizontalCheckRect, hObstacle)) {
+                resolveHorizontalCollision(hObstacle, tryX); // Ajuste tryX si collision
+            }
         }
         finalX = tryX; // X final est le résultat après collision H
     }
@@ -240,11 +395,15 @@ void Player::updateState() {
         }
 
         // Vérifier collision verticale avec les obstacles (en utilisant X final)
-        QRect verticalCheckRect = getCollisionRect(QPoint(finalX, tryY));
-        QWidget* vObstacle = nullptr;
-        if (checkCollision(verticalCheckRect, vObstacle)) {
-            // La fonction resolve met à jour m_velocityY et m_isJumpingOrFalling si nécessaire
-            resolveVerticalCollision(vObstacle, tryY);
+        // La fonction resolve met à jour m_velocityY et m_isJumpingOrFalling si nécessaire
+        if (m_occupancy) {
+            resolveVerticalCollisionOnGrid(finalX, currentY, tryY);
+        } else {
+            QRect verticalCheckRect = getCollisionRect(QPoint(finalX, tryY));
+            QWidget* vObstacle = nullptr;
+            if (checkCollision(verticalCheckRect, vObstacle)) {
+                resolveVerticalCollision(vObstacle, tryY);
+            }
         }
         finalY = tryY; // Y final est le résultat après collision V
 
@@ -273,6 +432,13 @@ void Player::updateState() {
     }
 
 
+    // Coyote time : rechargé tant qu'on est au sol, décompté une fois en l'air
+    if (!m_isJumpingOrFalling) {
+        m_coyoteRemaining = m_coyoteTicks;
+    } else if (m_coyoteRemaining > 0) {
+        --m_coyoteRemaining;
+    }
+
     // --- Phase 4: Mettre à jour l'animation ---
     if (m_isJumpingOrFalling) {
         // Mettre une frame de saut/chute si disponible
@@ -306,6 +472,9 @@ void Player::updateState() {
         move(finalX, finalY);
     }
 
+    metrics().ticks->inc();
+    metrics().tickDurationSeconds->observe((InputBuffer::nowNs() - tickStartNs) / 1e9);
+
     // --- Phase 6: Redessiner ---
     update(); // Toujours utile pour l'animation
 }
@@ -355,6 +524,44 @@ void Player::resolveHorizontalCollision(QWidget* obstacle, int& nextX) {
     }
 }
 
+// Version grille : seules les rangées entre l'ancienne et la nouvelle position sont examinées,
+// la première rangée solide rencontrée donne directement le bord de l'obstacle
+void Player::resolveVerticalCollisionOnGrid(int x, int currentY, int& nextY) {
+    metrics().collisionQueries->inc();
+    QRect box = getCollisionRect(QPoint(x, currentY));
+    QRect next = getCollisionRect(QPoint(x, nextY));
+
+    if (m_velocityY >= 0 && next.bottom() > box.bottom()) {
+        int row = m_occupancy->firstSolidRow(QRect(QPoint(box.left(), box.bottom() + 1), QPoint(box.right(), next.bottom())));
+        if (row >= 0) {
+            nextY = row - (m_frameHeight - COLLISION_MARGIN_BOTTOM);
+            m_velocityY = 0;
+            m_isJumpingOrFalling = false;
+        }
+    } else if (m_velocityY < 0 && next.top() < box.top()) {
+        int row = m_occupancy->lastSolidRow(QRect(QPoint(box.left(), next.top()), QPoint(box.right(), box.top() - 1)));
+        if (row >= 0) {
+            nextY = row + 1 - COLLISION_MARGIN_TOP;
+            m_velocityY = 0;
+        }
+    }
+}
+
+// Même principe sur les colonnes : le joueur s'arrête contre la première colonne solide balayée
+void Player::resolveHorizontalCollisionOnGrid(int currentX, int y, int& nextX) {
+    metrics().collisionQueries->inc();
+    QRect box = getCollisionRect(QPoint(currentX, y));
+    QRect next = getCollisionRect(QPoint(nextX, y));
+
+    if (next.right() > box.right()) {
+        int column = m_occupancy->firstSolidColumn(QRect(QPoint(box.right() + 1, box.top()), QPoint(next.right(), box.bottom())));
+        if (column >= 0) nextX = column - (m_frameWidth - COLLISION_MARGIN_RIGHT);
+    } else if (next.left() < box.left()) {
+        int column = m_occupancy->lastSolidColumn(QRect(QPoint(next.left(), box.top()), QPoint(box.left() - 1, box.bottom())));
+        if (column >= 0) nextX = column + 1 - COLLISION_MARGIN_LEFT;
+    }
+}
+
 // jump(), startMoving(), stopMoving(), getCurrentDirection(), setObstacles(),
 // getCollisionRect(), checkCollision(), setCurrentFrame(), paintEvent()
 // restent comme précédemment.
@@ -537,6 +744,7 @@ void Player::setCurrentFrame(int frame) {
 
 void Player::paintEvent(QPaintEvent* event) {
     Q_UNUSED(event);
+    qint64 paintStartNs = InputBuffer::nowNs();
     QPainter painter(this);
 
     int frameX = m_currentFrame * m_frameWidth;
@@ -552,12 +760,27 @@ void Player::paintEvent(QPaintEvent* event) {
         painter.translate(-m_frameWidth / 2.0, 0);
     }
 
-    painter.drawPixmap(targetRect, m_spritesheet, sourceRect);
+    if (m_spritesheet) {
+        painter.drawPixmap(targetRect, *m_spritesheet, sourceRect);
+    }
 
     if (flipHorizontally) {
         painter.restore();
     }
 
+    // Latence entrée -> dessin : les entrées appliquées par le dernier tick sont dessinées par ce paintEvent
+    if (!m_unpresentedInputs.isEmpty()) {
+        qint64 now = InputBuffer::nowNs();
+        for (qint64 timestamp : m_unpresentedInputs) {
+            m_inputLatency.addSample(now - timestamp);
+            metrics().inputLatencySeconds->observe((now - timestamp) / 1e9);
+        }
+        m_unpresentedInputs.clear();
+    }
+
+    metrics().framesPainted->inc();
+    metrics().paintDurationSeconds->observe((InputBuffer::nowNs() - paintStartNs) / 1e9);
+
     /* // Décommenter pour débugger la boîte de collision
     painter.setPen(Qt::red);
     QRect debugCollisionRect = getCollisionRect(pos());
@@ -5,9 +5,13 @@
 #include <QWidget>
 #include <QList> // Ajout pour QList
 #include "constants.h"
+#include "assetcache.h"
+#include "inputbuffer.h"
+#include "latencystats.h"
 
 class QPaintEvent;
 class QTimer;
+class OccupancyGrid;
 // QPoint n'a pas besoin d'être forward-déclaré si on inclut <QPoint> dans le .cpp,
 // mais on peut le faire pour être propre. class QPoint;
 
@@ -23,9 +27,17 @@ public:
     // --- Interface Publique ---
     void startMoving(Direction direction);
     void stopMoving();
-    void jump(); // Ajouté
+    void jump(); // Demande de saut, exécutée au prochain tick (avec buffer et coyote time)
     Direction getCurrentDirection() const;
     void setObstacles(const QList<QWidget*>& obstacles);
+    void setOccupancyGrid(const OccupancyGrid* grid); // Grille partagée du niveau (nullptr = tests par obstacle)
+    void setInputBuffer(InputBuffer* input); // Entrées consommées au début de chaque tick
+    void setJumpBufferMs(int ms);
+    void setCoyoteTimeMs(int ms);
+    const LatencyStats& inputLatency() const; // Latence entrée -> dessin (paintEvent du joueur)
+    void setTickTimerEnabled(bool enabled); // false : la simulation est avancée manuellement via step()
+    void step(); // Exécute un tick de simulation
+    void resetAt(const QPoint& topLeft); // Replace le joueur (réapparition) et oublie les entrées en cours
 
 protected:
     // --- Événements Surchargés ---
@@ -48,8 +60,14 @@ private:
     void resolveVerticalCollision(QWidget* obstacle, int& nextY);
     // Ajouté
     void resolveHorizontalCollision(QWidget* obstacle, int& nextX);
+    // Résolution depuis la grille : le bord bloquant est lu dans la zone balayée, sans parcourir les obstacles
+    void resolveVerticalCollisionOnGrid(int x, int currentY, int& nextY);
+    void resolveHorizontalCollisionOnGrid(int currentX, int y, int& nextX);
     // Ajouté
     bool isOnGround() const;
+    void processInput();
+    bool tryStartJump();
+    static int msToTicks(int ms);
 
     // --- Variables Membres ---
     int m_currentFrame;
@@ -57,16 +75,26 @@ private:
     int m_frameHeight;
     int m_totalFrames;
     int m_standingFrame;
-    QPixmap m_spritesheet;
+    AssetCache::PixmapHandle m_spritesheet; // Partagé entre toutes les instances via AssetCache
     QTimer* m_animationTimer;
     Direction m_currentDirection;
     Direction m_facingDirection;
     int m_speed;
     QList<QWidget*> m_obstacles;
+    const OccupancyGrid* m_occupancy;
 
     // --- Membres Ajoutés pour Saut/Gravité ---
     bool m_isJumpingOrFalling;
     double m_velocityY;
+
+    // --- Entrées, buffer de saut et coyote time (en ticks) ---
+    InputBuffer* m_input;
+    int m_jumpBufferTicks;
+    int m_coyoteTicks;
+    int m_jumpBufferRemaining;
+    int m_coyoteRemaining;
+    QVector<qint64> m_unpresentedInputs; // Horodatages des entrées appliquées mais pas encore dessinées
+    LatencyStats m_inputLatency;
 };
 
 #endif // PLAYER_H
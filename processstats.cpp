@@ -0,0 +1,114 @@
+#include "processstats.h"
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef Q_OS_LINUX
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+#ifdef JRGAME_COUNT_ALLOCATIONS
+namespace {
+
+std::atomic<qint64> g_allocations{0};
+std::atomic<qint64> g_deallocations{0};
+
+void* countedAllocate(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void countedFree(void* ptr) noexcept {
+    if (!ptr) return;
+    g_deallocations.fetch_add(1, std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+} // namespace
+
+// --- Remplacement des opérateurs globaux (comptage relaxé, coût négligeable) ---
+
+void* operator new(std::size_t size) {
+    if (void* ptr = countedAllocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = countedAllocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr); }
+#endif // JRGAME_COUNT_ALLOCATIONS
+
+namespace ProcessStats {
+
+qint64 residentMemoryBytes() {
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) return -1;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+qint64 peakResidentMemoryBytes() {
+#ifdef Q_OS_LINUX
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) return -1;
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for (const QByteArray& line : lines) {
+        if (line.startsWith("VmHWM:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024; // Valeur en kB
+        }
+    }
+#endif
+    return -1;
+}
+
+qint64 heapInUseBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // uordblks ne compte que l'arène ; les gros blocs (images, grilles) sont servis par mmap (hblkhd)
+    const struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+qint64 allocationCount() {
+#ifdef JRGAME_COUNT_ALLOCATIONS
+    return g_allocations.load(std::memory_order_relaxed);
+#else
+    return -1;
+#endif
+}
+
+qint64 deallocationCount() {
+#ifdef JRGAME_COUNT_ALLOCATIONS
+    return g_deallocations.load(std::memory_order_relaxed);
+#else
+    return -1;
+#endif
+}
+
+} // namespace ProcessStats
@@ -0,0 +1,21 @@
+#ifndef PROCESSSTATS_H
+#define PROCESSSTATS_H
+
+#include <QtGlobal>
+
+// Mesures mémoire du processus. Chaque fonction retourne -1 si la mesure n'est pas disponible sur la plateforme.
+namespace ProcessStats {
+
+qint64 residentMemoryBytes();     // RSS courant
+qint64 peakResidentMemoryBytes(); // RSS maximal depuis le démarrage (VmHWM)
+qint64 heapInUseBytes();          // Octets alloués via malloc et non libérés, blocs mmap compris (glibc)
+
+// Compteurs des opérateurs new/delete globaux, remplacés dans processstats.cpp uniquement si le projet
+// est compilé avec CONFIG+=soak (JRGAME_COUNT_ALLOCATIONS) ; -1 sinon.
+// Les conteneurs Qt allouent via malloc directement : heapInUseBytes() les couvre, pas ces compteurs.
+qint64 allocationCount();
+qint64 deallocationCount();
+
+} // namespace ProcessStats
+
+#endif // PROCESSSTATS_H
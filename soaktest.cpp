@@ -0,0 +1,181 @@
+#include "soaktest.h"
+#include "mainwindow.h"
+#include "levelgenerator.h"
+#include "latencystats.h"
+#include "processstats.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QRandomGenerator>
+
+namespace {
+
+double averageOf(const QVector<double>& values) {
+    if (values.isEmpty()) return 0.0;
+    double sum = 0.0;
+    for (double value : values) sum += value;
+    return sum / values.size();
+}
+
+} // namespace
+
+SoakTest::SoakTest(const Options& options)
+    : m_options(options)
+{
+}
+
+int SoakTest::run() {
+    MainWindow window;
+    window.setAttribute(Qt::WA_DontShowOnScreen);
+    window.show();
+    window.setManualStepping(true);
+    window.loadLevel(LevelGenerator::generate(m_options.seed, m_options.levelWidth, window.height()));
+
+    QImage frame(window.size(), QImage::Format_ARGB32_Premultiplied); // Réutilisée à chaque tick
+    QRandomGenerator inputRng(m_options.seed ^ 0x9e3779b9u);
+    LatencyStats frameTimes(SOAK_WINDOW_TICKS);
+
+    qDebug().noquote() << QStringLiteral("Soak: graine %1, niveau de %2 px, %3 s")
+                              .arg(m_options.seed).arg(m_options.levelWidth).arg(m_options.durationSeconds);
+
+    QElapsedTimer clock;
+    clock.start();
+    const qint64 durationNs = qint64(m_options.durationSeconds) * 1000000000LL;
+    const bool countingAllocations = ProcessStats::allocationCount() >= 0;
+    if (!countingAllocations) {
+        qDebug() << "Soak: comptage new/delete non compilé (qmake CONFIG+=soak), suivi des allocations vivantes désactivé";
+    }
+    qint64 allocationsAtWindowStart = ProcessStats::allocationCount();
+    int tick = 0;
+
+    while (clock.nsecsElapsed() < durationNs) {
+        driveInput(window, inputRng);
+
+        // Temps de frame = simulation + rendu complet de la scène
+        qint64 frameStart = clock.nsecsElapsed();
+        window.stepSimulation();
+        window.renderFrame(frame);
+        frameTimes.addSample(clock.nsecsElapsed() - frameStart);
+
+        // Comme la boucle d'événements normale : traite les événements postés (repaints, suppressions différées)
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+
+        if (window.isPlayerAtLevelEnd()) {
+            window.respawnPlayer(); // Même niveau en boucle : la mémoire attendue reste constante
+        }
+
+        if (++tick % SOAK_WINDOW_TICKS == 0) {
+            qint64 allocations = ProcessStats::allocationCount();
+            Window sample;
+            sample.elapsedSeconds = clock.nsecsElapsed() / 1e9;
+            sample.residentBytes = ProcessStats::residentMemoryBytes();
+            sample.peakResidentBytes = ProcessStats::peakResidentMemoryBytes();
+            sample.heapBytes = ProcessStats::heapInUseBytes();
+            sample.liveAllocations = countingAllocations ? allocations - ProcessStats::deallocationCount() : -1;
+            sample.allocations = countingAllocations ? allocations - allocationsAtWindowStart : -1;
+            sample.frameP50Ms = frameTimes.percentileNs(50) / 1e6;
+            sample.frameP95Ms = frameTimes.percentileNs(95) / 1e6;
+            sample.frameP99Ms = frameTimes.percentileNs(99) / 1e6;
+            m_windows.append(sample);
+            logWindow(m_windows.size() - 1, sample);
+
+            frameTimes.reset();
+            allocationsAtWindowStart = ProcessStats::allocationCount();
+        }
+    }
+
+    return evaluate() ? 0 : 1;
+}
+
+// Entrées aléatoires biaisées vers la droite pour parcourir le niveau, avec sauts fréquents (trous, plateformes)
+void SoakTest::driveInput(MainWindow& window, QRandomGenerator& rng) {
+    InputBuffer& input = window.inputBuffer();
+    int roll = rng.bounded(100);
+    if (roll < 4) {
+        input.push(InputBuffer::Action::MoveRight, true);
+    } else if (roll < 5) {
+        input.push(InputBuffer::Action::MoveLeft, true);
+    } else if (roll < 6) {
+        input.push(InputBuffer::Action::MoveLeft, false);
+        input.push(InputBuffer::Action::MoveRight, false);
+    } else if (roll < 10) {
+        input.push(InputBuffer::Action::Jump, true);
+        input.push(InputBuffer::Action::Jump, false);
+    }
+}
+
+void SoakTest::logWindow(int index, const Window& window) const {
+    auto mib = [](qint64 bytes) { return bytes < 0 ? QStringLiteral("n/a") : QString::number(bytes / (1024.0 * 1024.0), 'f', 1); };
+    auto count = [](qint64 value) { return value < 0 ? QStringLiteral("n/a") : QString::number(value); };
+    qDebug().noquote() << QStringLiteral("Soak [%1] t=%2s rss=%3MiB pic=%4MiB tas=%5MiB allocs=%6 vivantes=%7 frame p50=%8ms p95=%9ms p99=%10ms")
+                              .arg(index)
+                              .arg(window.elapsedSeconds, 0, 'f', 1)
+                              .arg(mib(window.residentBytes), mib(window.peakResidentBytes), mib(window.heapBytes))
+                              .arg(count(window.allocations), count(window.liveAllocations))
+                              .arg(window.frameP50Ms, 0, 'f', 2)
+                              .arg(window.frameP95Ms, 0, 'f', 2)
+                              .arg(window.frameP99Ms, 0, 'f', 2);
+}
+
+// Compare la moyenne des premières fenêtres (après préchauffage) à celle des dernières
+bool SoakTest::evaluate() const {
+    const int usable = m_windows.size() - SOAK_WARMUP_WINDOWS;
+    if (usable < 2 * SOAK_TREND_WINDOWS) {
+        qWarning() << "Soak: durée trop courte pour évaluer une tendance (" << m_windows.size() << "fenêtres mesurées,"
+                   << SOAK_WARMUP_WINDOWS + 2 * SOAK_TREND_WINDOWS << "nécessaires)";
+        return false;
+    }
+
+    auto trend = [this](auto field, bool atEnd) {
+        QVector<double> values;
+        int first = atEnd ? m_windows.size() - SOAK_TREND_WINDOWS : SOAK_WARMUP_WINDOWS;
+        for (int i = first; i < first + SOAK_TREND_WINDOWS; ++i) {
+            values.append(field(m_windows.at(i)));
+        }
+        return averageOf(values);
+    };
+
+    bool stable = true;
+
+    // Mémoire : le tas (malloc, glibc) et le RSS sont vérifiés tous les deux, chacun s'il est disponible ;
+    // le RSS voit aussi ce qui échappe à malloc (pixmaps du serveur graphique, mmap directs)
+    auto checkMemory = [&](const QString& label, auto field) {
+        if (field(m_windows.constLast()) < 0) return; // Mesure indisponible sur cette plateforme
+        double memoryStart = trend(field, false);
+        double memoryEnd = trend(field, true);
+        if (memoryStart > 0 && memoryEnd > memoryStart * (1.0 + SOAK_MAX_MEMORY_GROWTH)) {
+            qWarning().noquote() << QStringLiteral("Soak ÉCHEC: fuite probable, %1 passe de %2 à %3 octets")
+                                        .arg(label).arg(qint64(memoryStart)).arg(qint64(memoryEnd));
+            stable = false;
+        }
+    };
+    checkMemory(QStringLiteral("le tas"), [](const Window& w) { return double(w.heapBytes); });
+    checkMemory(QStringLiteral("le RSS"), [](const Window& w) { return double(w.residentBytes); });
+
+    // Allocations vivantes (new/delete) : doivent rester stables d'une fenêtre à l'autre (build CONFIG+=soak uniquement)
+    if (m_windows.constLast().liveAllocations >= 0) {
+        auto live = [](const Window& w) { return double(w.liveAllocations); };
+        double liveStart = trend(live, false);
+        double liveEnd = trend(live, true);
+        if (liveStart > 0 && liveEnd > liveStart * (1.0 + SOAK_MAX_MEMORY_GROWTH)) {
+            qWarning().noquote() << QStringLiteral("Soak ÉCHEC: allocations vivantes en hausse, de %1 à %2")
+                                        .arg(qint64(liveStart)).arg(qint64(liveEnd));
+            stable = false;
+        }
+    }
+
+    // Temps de frame : dérive du p95, ignorée si l'écart absolu reste sous le bruit de mesure
+    auto p95 = [](const Window& w) { return w.frameP95Ms; };
+    double p95Start = trend(p95, false);
+    double p95End = trend(p95, true);
+    if (p95End > p95Start * (1.0 + SOAK_MAX_LATENCY_DRIFT) && p95End - p95Start > SOAK_MIN_LATENCY_DRIFT_MS) {
+        qWarning().noquote() << QStringLiteral("Soak ÉCHEC: dérive du temps de frame, p95 de %1 ms à %2 ms")
+                                    .arg(p95Start, 0, 'f', 2).arg(p95End, 0, 'f', 2);
+        stable = false;
+    }
+
+    qDebug().noquote() << (stable ? QStringLiteral("Soak: stable") : QStringLiteral("Soak: instable"))
+                       << QStringLiteral("(pic RSS %1 MiB)").arg(m_windows.constLast().peakResidentBytes / (1024.0 * 1024.0), 0, 'f', 1);
+    return stable;
+}
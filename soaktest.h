@@ -0,0 +1,49 @@
+#ifndef SOAKTEST_H
+#define SOAKTEST_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "constants.h"
+
+class MainWindow;
+class QRandomGenerator;
+
+// Test d'endurance : joue un niveau généré avec des entrées aléatoires (déterministes pour une graine)
+// pendant une durée donnée, et suit mémoire, allocations et temps de frame par fenêtres successives.
+// Échoue si la mémoire croît (fuite) ou si le p95 du temps de frame dérive entre le début et la fin.
+class SoakTest
+{
+public:
+    struct Options {
+        quint32 seed = 1;
+        int levelWidth = LEVEL_DEFAULT_WIDTH;
+        int durationSeconds = SOAK_DEFAULT_SECONDS; // Temps réel (horloge murale)
+    };
+
+    explicit SoakTest(const Options& options);
+
+    int run(); // Code de sortie : 0 si stable, 1 sinon
+
+private:
+    // Mesures d'une fenêtre de SOAK_WINDOW_TICKS ticks
+    struct Window {
+        double elapsedSeconds;
+        qint64 residentBytes;
+        qint64 peakResidentBytes;
+        qint64 heapBytes;
+        qint64 liveAllocations; // new - delete (-1 si le comptage n'est pas compilé)
+        qint64 allocations;     // new pendant la fenêtre (-1 si le comptage n'est pas compilé)
+        double frameP50Ms;
+        double frameP95Ms;
+        double frameP99Ms;
+    };
+
+    void driveInput(MainWindow& window, QRandomGenerator& rng);
+    void logWindow(int index, const Window& window) const;
+    bool evaluate() const;
+
+    Options m_options;
+    QVector<Window> m_windows;
+};
+
+#endif // SOAKTEST_H